@@ -0,0 +1,79 @@
+#ifndef SQLITEPP_BENCH_H
+#define SQLITEPP_BENCH_H
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <limits>
+
+#include "sqlitepp.h"
+
+namespace bench
+{
+
+typedef std::chrono::steady_clock clock;
+
+// keeps the optimizer from dropping the measured work
+extern volatile int64_t sink;
+
+inline void do_not_optimize(int64_t value)
+{
+    sink = value;
+}
+
+// runs 'body' a few times and reports the best time per item
+template <typename Body>
+void run(const char* group, const char* name, size_t items, Body body, int repeats = 5)
+{
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < repeats; ++i)
+    {
+        const auto start = clock::now();
+        body();
+        const std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+
+        if (elapsed.count() < best)
+        {
+            best = elapsed.count();
+        }
+    }
+
+    std::printf("%-10s %-44s %12.2f ns/item\n", group, name, best / (double)items);
+}
+
+// fills 't' with 'rows' rows of (INTEGER, REAL, 200 byte TEXT, 64 byte BLOB)
+const char* const seed_query =
+    "CREATE TABLE t(i INTEGER, d REAL, s TEXT, b BLOB);"
+    "WITH RECURSIVE c(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM c WHERE x < 100000) "
+    "INSERT INTO t SELECT x, x * 0.5, printf('%0200d', x), zeroblob(64) FROM c;";
+
+const size_t seed_rows = 100000;
+
+inline sqlite3* open_raw()
+{
+    sqlite3* handle = nullptr;
+    sqlite3_open(":memory:", &handle);
+    sqlite3_exec(handle, seed_query, nullptr, nullptr, nullptr);
+
+    return handle;
+}
+
+inline sqlitepp::database open_wrapped()
+{
+    int code = SQLITE_OK;
+    sqlitepp::database db(":memory:", code);
+    db.execute(seed_query);
+
+    return db;
+}
+
+void prepare_statements();
+void bind_parameters();
+void step_rows();
+void read_columns();
+void insert_rows();
+void point_lookup();
+
+} // bench
+
+#endif // SQLITEPP_BENCH_H
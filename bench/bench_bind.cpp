@@ -0,0 +1,81 @@
+#include "bench.h"
+
+namespace bench
+{
+
+namespace
+{
+    const size_t iterations = 1000000;
+
+    // binding parameter 1 of type T, next to the equivalent C call
+    template <typename T, typename RawBind>
+    void compare(const char* raw_name, const char* wrapped_name, const T& value, RawBind raw_bind)
+    {
+        sqlite3* handle = nullptr;
+        sqlite3_open(":memory:", &handle);
+
+        sqlite3_stmt* raw = nullptr;
+        sqlite3_prepare_v2(handle, "SELECT ?", -1, &raw, nullptr);
+
+        run("bind", raw_name, iterations, [&]()
+        {
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                raw_bind(raw, value);
+            }
+        });
+
+        sqlite3_finalize(raw);
+        sqlite3_close(handle);
+
+        int code = SQLITE_OK;
+        sqlitepp::database db(":memory:", code);
+        auto stmt = db.prepare("SELECT ?");
+
+        run("bind", wrapped_name, iterations, [&]()
+        {
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                stmt.bind_at(1, value);
+            }
+        });
+    }
+}
+
+void bind_parameters()
+{
+    compare("sqlite3_bind_int", "int32_t", (int32_t)42, [](sqlite3_stmt* stmt, int32_t value)
+    {
+        sqlite3_bind_int(stmt, 1, value);
+    });
+
+    compare("sqlite3_bind_int64", "int64_t", (int64_t)42, [](sqlite3_stmt* stmt, int64_t value)
+    {
+        sqlite3_bind_int64(stmt, 1, value);
+    });
+
+    compare("sqlite3_bind_double", "double", 42.0, [](sqlite3_stmt* stmt, double value)
+    {
+        sqlite3_bind_double(stmt, 1, value);
+    });
+
+    const std::string text(200, 'x');
+    compare("sqlite3_bind_text", "std::string", text, [](sqlite3_stmt* stmt, const std::string& value)
+    {
+        sqlite3_bind_text(stmt, 1, value.data(), (int)value.size(), SQLITE_STATIC);
+    });
+
+    const std::vector<char> bytes(64, 'x');
+    compare("sqlite3_bind_blob", "std::vector<char>", bytes, [](sqlite3_stmt* stmt, const std::vector<char>& value)
+    {
+        sqlite3_bind_blob(stmt, 1, value.data(), (int)value.size(), SQLITE_STATIC);
+    });
+
+    const sqlitepp::const_blob blob = { bytes.data(), bytes.size() };
+    compare("sqlite3_bind_blob (pointer)", "const_blob", blob, [](sqlite3_stmt* stmt, const sqlitepp::const_blob& value)
+    {
+        sqlite3_bind_blob(stmt, 1, value.ptr, (int)value.length, SQLITE_STATIC);
+    });
+}
+
+} // bench
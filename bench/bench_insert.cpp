@@ -0,0 +1,84 @@
+#include "bench.h"
+
+namespace bench
+{
+
+namespace
+{
+    const char* const create_query = "CREATE TABLE u(i INTEGER, d REAL, s TEXT)";
+    const char* const insert_query = "INSERT INTO u VALUES (?, ?, ?)";
+    const size_t rows = 100000;
+
+    typedef std::tuple<int64_t, double, std::string> row_type;
+
+    std::vector<row_type> make_rows()
+    {
+        std::vector<row_type> values;
+        values.reserve(rows);
+
+        for (size_t i = 0; i < rows; ++i)
+        {
+            values.emplace_back((int64_t)i, i * 0.5, std::string(32, 'a' + (char)(i % 26)));
+        }
+
+        return values;
+    }
+
+    sqlitepp::database open_empty()
+    {
+        int code = SQLITE_OK;
+        sqlitepp::database db(":memory:", code);
+        db.execute(create_query);
+
+        return db;
+    }
+}
+
+void insert_rows()
+{
+    const auto values = make_rows();
+
+    run("insert", "raw C API, one transaction", rows, [&]()
+    {
+        sqlite3* handle = nullptr;
+        sqlite3_open(":memory:", &handle);
+        sqlite3_exec(handle, create_query, nullptr, nullptr, nullptr);
+
+        sqlite3_stmt* stmt = nullptr;
+        sqlite3_prepare_v2(handle, insert_query, -1, &stmt, nullptr);
+
+        sqlite3_exec(handle, "BEGIN", nullptr, nullptr, nullptr);
+        for (const auto& row : values)
+        {
+            const auto& text = std::get<2>(row);
+
+            sqlite3_bind_int64(stmt, 1, std::get<0>(row));
+            sqlite3_bind_double(stmt, 2, std::get<1>(row));
+            sqlite3_bind_text(stmt, 3, text.data(), (int)text.size(), SQLITE_STATIC);
+            sqlite3_step(stmt);
+            sqlite3_reset(stmt);
+        }
+        sqlite3_exec(handle, "COMMIT", nullptr, nullptr, nullptr);
+
+        sqlite3_finalize(stmt);
+        sqlite3_close(handle);
+    }, 3);
+
+    run("insert", "database::insert_many", rows, [&]()
+    {
+        auto db = open_empty();
+        db.insert_many(insert_query, values);
+    }, 3);
+
+    run("insert", "bulk_insert<3>", rows, [&]()
+    {
+        auto db = open_empty();
+        sqlitepp::bulk_insert<3> insert(db, "u", {{ "i", "d", "s" }});
+
+        sqlitepp::transaction tx(db, sqlitepp::transaction_mode::immediate);
+        insert.insert(values);
+        tx.commit();
+    }, 3);
+}
+
+} // bench
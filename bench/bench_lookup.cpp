@@ -0,0 +1,85 @@
+#include "bench.h"
+
+namespace bench
+{
+
+namespace
+{
+    const char* const lookup_query = "SELECT d, s FROM t WHERE rowid = ?";
+    const size_t lookups = 100000;
+
+    int64_t key(size_t i)
+    {
+        // spread the lookups over the whole table
+        return (int64_t)((i * 7919) % seed_rows) + 1;
+    }
+}
+
+void point_lookup()
+{
+    sqlite3* handle = open_raw();
+    sqlite3_stmt* raw = nullptr;
+    sqlite3_prepare_v2(handle, lookup_query, -1, &raw, nullptr);
+
+    run("lookup", "raw C API, prepared once", lookups, [&]()
+    {
+        int64_t sum = 0;
+        for (size_t i = 0; i < lookups; ++i)
+        {
+            sqlite3_bind_int64(raw, 1, key(i));
+            if (sqlite3_step(raw) == SQLITE_ROW)
+            {
+                sum += (int64_t)sqlite3_column_double(raw, 0);
+                sum += sqlite3_column_bytes(raw, 1);
+            }
+
+            sqlite3_reset(raw);
+        }
+
+        do_not_optimize(sum);
+    });
+
+    sqlite3_finalize(raw);
+    sqlite3_close(handle);
+
+    auto db = open_wrapped();
+    auto stmt = db.prepare(lookup_query);
+
+    run("lookup", "statement::rebind, prepared once", lookups, [&]()
+    {
+        int64_t sum = 0;
+        double d = 0;
+        sqlitepp::text_view s = { nullptr, 0 };
+        for (size_t i = 0; i < lookups; ++i)
+        {
+            stmt.rebind(key(i));
+            if (stmt.next_row())
+            {
+                stmt.read_columns(d, s);
+                sum += (int64_t)d + (int64_t)s.length;
+            }
+        }
+
+        do_not_optimize(sum);
+    });
+
+    run("lookup", "database::prepare_cached", lookups, [&]()
+    {
+        int64_t sum = 0;
+        double d = 0;
+        sqlitepp::text_view s = { nullptr, 0 };
+        for (size_t i = 0; i < lookups; ++i)
+        {
+            auto cached = db.prepare_cached(lookup_query, key(i));
+            if (cached->next_row())
+            {
+                cached->read_columns(d, s);
+                sum += (int64_t)d + (int64_t)s.length;
+            }
+        }
+
+        do_not_optimize(sum);
+    });
+}
+
+} // bench
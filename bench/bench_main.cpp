@@ -0,0 +1,21 @@
+#include "bench.h"
+
+volatile int64_t bench::sink = 0;
+
+int main()
+{
+#ifdef SQLITEPP_INLINE_BINDINGS
+    std::printf("sqlitepp %s, inline bindings\n\n", sqlite3_libversion());
+#else
+    std::printf("sqlitepp %s, out-of-line bindings\n\n", sqlite3_libversion());
+#endif // SQLITEPP_INLINE_BINDINGS
+
+    bench::prepare_statements();
+    bench::bind_parameters();
+    bench::step_rows();
+    bench::read_columns();
+    bench::insert_rows();
+    bench::point_lookup();
+
+    return 0;
+}
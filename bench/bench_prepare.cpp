@@ -0,0 +1,47 @@
+#include "bench.h"
+
+namespace bench
+{
+
+namespace
+{
+    const char* const lookup_query = "SELECT i, d, s FROM t WHERE rowid = ?";
+    const size_t iterations = 20000;
+}
+
+void prepare_statements()
+{
+    sqlite3* handle = open_raw();
+
+    run("prepare", "sqlite3_prepare_v2 + finalize", iterations, [&]()
+    {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            sqlite3_stmt* stmt = nullptr;
+            sqlite3_prepare_v2(handle, lookup_query, -1, &stmt, nullptr);
+            sqlite3_finalize(stmt);
+        }
+    });
+
+    sqlite3_close(handle);
+
+    auto db = open_wrapped();
+
+    run("prepare", "database::prepare", iterations, [&]()
+    {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            auto stmt = db.prepare(lookup_query);
+        }
+    });
+
+    run("prepare", "database::prepare_cached", iterations, [&]()
+    {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            auto stmt = db.prepare_cached(lookup_query);
+        }
+    });
+}
+
+} // bench
@@ -0,0 +1,228 @@
+#include "bench.h"
+
+namespace bench
+{
+
+namespace
+{
+    int64_t checksum(int32_t value) { return value; }
+    int64_t checksum(int64_t value) { return value; }
+    int64_t checksum(double value) { return (int64_t)value; }
+    int64_t checksum(const std::string& value) { return value.back(); }
+    int64_t checksum(const std::vector<char>& value) { return (int64_t)value.size(); }
+    int64_t checksum(const sqlitepp::text_view& value) { return value.ptr[value.length - 1]; }
+    int64_t checksum(const sqlitepp::blob_view& value) { return (int64_t)value.length; }
+
+    // one column of type T through the wrapper, next to the equivalent C calls
+    template <typename T, typename RawRead>
+    void compare(const char* raw_name, const char* wrapped_name, const char* query, RawRead raw_read)
+    {
+        sqlite3* handle = open_raw();
+        sqlite3_stmt* raw = nullptr;
+        sqlite3_prepare_v2(handle, query, -1, &raw, nullptr);
+
+        run("read", raw_name, seed_rows, [&]()
+        {
+            int64_t sum = 0;
+            while (sqlite3_step(raw) == SQLITE_ROW)
+            {
+                sum += raw_read(raw);
+            }
+
+            sqlite3_reset(raw);
+            do_not_optimize(sum);
+        });
+
+        sqlite3_finalize(raw);
+        sqlite3_close(handle);
+
+        auto db = open_wrapped();
+        auto stmt = db.prepare(query);
+
+        run("read", wrapped_name, seed_rows, [&]()
+        {
+            int64_t sum = 0;
+            T value = T();
+            while (stmt.next_row())
+            {
+                stmt.read_columns(value);
+                sum += checksum(value);
+            }
+
+            stmt.reset();
+            do_not_optimize(sum);
+        });
+    }
+
+    void fixed_blob()
+    {
+        const char* const query = "SELECT b FROM t";
+
+        sqlite3* handle = open_raw();
+        sqlite3_stmt* raw = nullptr;
+        sqlite3_prepare_v2(handle, query, -1, &raw, nullptr);
+
+        char buffer[64] = {};
+        run("read", "sqlite3_column_blob + memcpy(64)", seed_rows, [&]()
+        {
+            int64_t sum = 0;
+            while (sqlite3_step(raw) == SQLITE_ROW)
+            {
+                if (sqlite3_column_bytes(raw, 0) == (int)sizeof(buffer))
+                {
+                    memcpy(buffer, sqlite3_column_blob(raw, 0), sizeof(buffer));
+                    sum += buffer[0];
+                }
+            }
+
+            sqlite3_reset(raw);
+            do_not_optimize(sum);
+        });
+
+        sqlite3_finalize(raw);
+        sqlite3_close(handle);
+
+        auto db = open_wrapped();
+        auto stmt = db.prepare(query);
+
+        run("read", "blob{ char[64] }", seed_rows, [&]()
+        {
+            int64_t sum = 0;
+            sqlitepp::blob value = { buffer, sizeof(buffer) };
+            while (stmt.next_row())
+            {
+                stmt.read_columns(value);
+                sum += buffer[0];
+            }
+
+            stmt.reset();
+            do_not_optimize(sum);
+        });
+    }
+
+    void multiple_columns()
+    {
+        const char* const query = "SELECT i, d, s FROM t";
+        const size_t columns = 3;
+
+        sqlite3* handle = open_raw();
+        sqlite3_stmt* raw = nullptr;
+        sqlite3_prepare_v2(handle, query, -1, &raw, nullptr);
+
+        run("read", "raw C API (i, d, s)", seed_rows * columns, [&]()
+        {
+            int64_t sum = 0;
+            while (sqlite3_step(raw) == SQLITE_ROW)
+            {
+                sum += sqlite3_column_int64(raw, 0);
+                sum += (int64_t)sqlite3_column_double(raw, 1);
+
+                const auto* text = sqlite3_column_text(raw, 2);
+                sum += text[sqlite3_column_bytes(raw, 2) - 1];
+            }
+
+            sqlite3_reset(raw);
+            do_not_optimize(sum);
+        });
+
+        sqlite3_finalize(raw);
+        sqlite3_close(handle);
+
+        auto db = open_wrapped();
+        auto stmt = db.prepare(query);
+
+        run("read", "read_columns(int64_t, double, std::string)", seed_rows * columns, [&]()
+        {
+            int64_t sum = 0;
+            int64_t i = 0;
+            double d = 0;
+            std::string s;
+            while (stmt.next_row())
+            {
+                stmt.read_columns(i, d, s);
+                sum += i + (int64_t)d + s.back();
+            }
+
+            stmt.reset();
+            do_not_optimize(sum);
+        });
+
+        run("read", "read_columns(int64_t, double, text_view)", seed_rows * columns, [&]()
+        {
+            int64_t sum = 0;
+            int64_t i = 0;
+            double d = 0;
+            sqlitepp::text_view s = { nullptr, 0 };
+            while (stmt.next_row())
+            {
+                stmt.read_columns(i, d, s);
+                sum += i + (int64_t)d + s.ptr[s.length - 1];
+            }
+
+            stmt.reset();
+            do_not_optimize(sum);
+        });
+
+        run("read", "rows<int64_t, double, text_view>", seed_rows * columns, [&]()
+        {
+            int64_t sum = 0;
+            for (const auto& row : stmt.rows<int64_t, double, sqlitepp::text_view>())
+            {
+                const auto& s = std::get<2>(row);
+                sum += std::get<0>(row) + (int64_t)std::get<1>(row) + s.ptr[s.length - 1];
+            }
+
+            stmt.reset();
+            do_not_optimize(sum);
+        });
+    }
+}
+
+void read_columns()
+{
+    compare<int32_t>("sqlite3_column_int", "int32_t", "SELECT i FROM t", [](sqlite3_stmt* stmt)
+    {
+        return (int64_t)sqlite3_column_int(stmt, 0);
+    });
+
+    compare<int64_t>("sqlite3_column_int64", "int64_t", "SELECT i FROM t", [](sqlite3_stmt* stmt)
+    {
+        return sqlite3_column_int64(stmt, 0);
+    });
+
+    compare<double>("sqlite3_column_double", "double", "SELECT d FROM t", [](sqlite3_stmt* stmt)
+    {
+        return (int64_t)sqlite3_column_double(stmt, 0);
+    });
+
+    compare<std::string>("sqlite3_column_text + std::string", "std::string", "SELECT s FROM t", [](sqlite3_stmt* stmt)
+    {
+        const auto* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+        const std::string value(text, (size_t)sqlite3_column_bytes(stmt, 0));
+        return (int64_t)value.back();
+    });
+
+    compare<sqlitepp::text_view>("sqlite3_column_text", "text_view", "SELECT s FROM t", [](sqlite3_stmt* stmt)
+    {
+        const auto* text = sqlite3_column_text(stmt, 0);
+        return (int64_t)text[sqlite3_column_bytes(stmt, 0) - 1];
+    });
+
+    compare<std::vector<char>>("sqlite3_column_blob + std::vector", "std::vector<char>", "SELECT b FROM t", [](sqlite3_stmt* stmt)
+    {
+        const auto* ptr = static_cast<const char*>(sqlite3_column_blob(stmt, 0));
+        const std::vector<char> value(ptr, ptr + sqlite3_column_bytes(stmt, 0));
+        return (int64_t)value.size();
+    });
+
+    compare<sqlitepp::blob_view>("sqlite3_column_blob", "blob_view", "SELECT b FROM t", [](sqlite3_stmt* stmt)
+    {
+        sqlite3_column_blob(stmt, 0);
+        return (int64_t)sqlite3_column_bytes(stmt, 0);
+    });
+
+    fixed_blob();
+    multiple_columns();
+}
+
+} // bench
@@ -0,0 +1,45 @@
+#include "bench.h"
+
+namespace bench
+{
+
+void step_rows()
+{
+    const char* const query = "SELECT i FROM t";
+
+    sqlite3* handle = open_raw();
+    sqlite3_stmt* raw = nullptr;
+    sqlite3_prepare_v2(handle, query, -1, &raw, nullptr);
+
+    run("step", "sqlite3_step", seed_rows, [&]()
+    {
+        int64_t rows = 0;
+        while (sqlite3_step(raw) == SQLITE_ROW)
+        {
+            ++rows;
+        }
+
+        sqlite3_reset(raw);
+        do_not_optimize(rows);
+    });
+
+    sqlite3_finalize(raw);
+    sqlite3_close(handle);
+
+    auto db = open_wrapped();
+    auto stmt = db.prepare(query);
+
+    run("step", "statement::next_row", seed_rows, [&]()
+    {
+        int64_t rows = 0;
+        while (stmt.next_row())
+        {
+            ++rows;
+        }
+
+        stmt.reset();
+        do_not_optimize(rows);
+    });
+}
+
+} // bench
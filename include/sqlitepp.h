@@ -2,5 +2,11 @@
 #define SQLITEPP_H
 
 #include "sqlitepp_db.h"
+#include "sqlitepp_alloc.h"
+#include "sqlitepp_async.h"
+#include "sqlitepp_bulk.h"
+#include "sqlitepp_config.h"
+#include "sqlitepp_pool.h"
+#include "sqlitepp_transaction.h"
 
 #endif // SQLITEPP_H
@@ -0,0 +1,80 @@
+#ifndef SQLITEPP_ALLOC_H
+#define SQLITEPP_ALLOC_H
+
+#include <cstddef>
+
+#include "sqlite3_inc.h"
+
+namespace sqlitepp
+{
+
+// malloc with per thread free lists for small power of two size classes,
+// so threads stop contending on the global heap for SQLite's many small
+// allocations, install it with global_config::set_allocator(thread_caching_allocator::methods())
+class thread_caching_allocator
+{
+public:
+    thread_caching_allocator() = delete;
+
+    static constexpr size_t min_class_size = 16;
+    static constexpr size_t max_class_size = 4096;
+    static constexpr size_t class_count = 9;
+
+    // blocks kept per size class and thread, the rest goes back to malloc
+    static constexpr size_t max_cached_blocks = 64;
+
+    static const sqlite3_mem_methods& methods();
+
+    static void* allocate(int size);
+    static void release(void* ptr);
+    static void* reallocate(void* ptr, int size);
+    static int size_of(void* ptr);
+    static int round_up(int size);
+};
+
+// a preallocated memory region, e.g. for global_config::set_page_cache,
+// backed by huge pages when requested and available; size() is then
+// rounded up to a whole number of huge pages
+class memory_region
+{
+public:
+    memory_region() noexcept = default;
+    memory_region(size_t size, bool huge_pages);
+    memory_region(memory_region&&) noexcept;
+    memory_region(const memory_region&) = delete;
+    memory_region& operator=(memory_region&&) noexcept;
+    memory_region& operator=(const memory_region&) = delete;
+    ~memory_region();
+
+    void* data() const
+    {
+        return m_data;
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    bool ok() const
+    {
+        return m_data != nullptr;
+    }
+
+    bool is_huge_pages() const
+    {
+        return m_huge_pages;
+    }
+
+private:
+    void release();
+
+    void* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_huge_pages = false;
+    bool m_mapped = false;
+};
+
+} // sqlitepp
+
+#endif // SQLITEPP_ALLOC_H
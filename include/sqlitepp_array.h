@@ -0,0 +1,36 @@
+#ifndef SQLITEPP_ARRAY_H
+#define SQLITEPP_ARRAY_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "sqlite3_inc.h"
+
+namespace sqlitepp
+{
+
+namespace detail
+{
+    // what an array parameter carries through sqlite3_bind_pointer; the values are
+    // either borrowed from the caller or moved into 'owned_*' by an rvalue bind
+    struct array_pointer
+    {
+        const int64_t* integers = nullptr;
+        const std::string* texts = nullptr;
+        size_t size = 0;
+
+        std::vector<int64_t> owned_integers;
+        std::vector<std::string> owned_texts;
+    };
+
+    // pointer type checked by sqlite3_value_pointer, has to be a static string
+    extern const char* const array_pointer_type;
+
+    const sqlite3_module* get_array_module();
+}
+
+} // sqlitepp
+
+#endif // SQLITEPP_ARRAY_H
@@ -0,0 +1,109 @@
+#ifndef SQLITEPP_ASYNC_H
+#define SQLITEPP_ASYNC_H
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <type_traits>
+#include <condition_variable>
+
+#include "sqlite3_inc.h"
+#include "sqlitepp_db.h"
+
+namespace sqlitepp
+{
+
+// runs jobs against connections owned by worker threads, one connection and
+// one queue per worker, so a slow job only delays the jobs queued behind it
+class async_database
+{
+public:
+    typedef std::function<void(database&)> job_type;
+
+    // milliseconds a worker waits on a database locked by another one
+    static constexpr int default_busy_timeout = 5000;
+
+    async_database() noexcept = default;
+    async_database(const char* db, size_t workers, int& result, int busy_timeout = default_busy_timeout);
+    async_database(const async_database&) = delete;
+    async_database& operator=(const async_database&) = delete;
+    ~async_database();
+
+    // every worker opens its own connection, so 'db' has to be a file for them to share data
+    int open(const char* db, size_t workers, int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE,
+        int busy_timeout = default_busy_timeout);
+    // finishes the queued jobs and joins the workers
+    void close();
+
+    // queued on the worker with the fewest pending jobs; when it can't be queued
+    // (not opened, no such worker) the future reports std::future_errc::broken_promise
+    template <typename Job>
+    std::future<typename std::result_of<Job(database&)>::type> submit(Job&& job);
+    template <typename Job>
+    std::future<typename std::result_of<Job(database&)>::type> submit_to(size_t worker, Job&& job);
+
+    // fire and forget, the job reports its own completion and anything it throws is dropped;
+    // SQLITE_MISUSE when there's no such worker
+    int post(job_type job);
+    int post_to(size_t worker, job_type job);
+
+    size_t get_worker_count() const
+    {
+        return m_workers.size();
+    }
+
+    // 0 when there's no such worker
+    size_t get_pending_jobs(size_t worker) const
+    {
+        return (worker < m_workers.size())
+            ? m_workers[worker]->pending.load(std::memory_order_relaxed)
+            : 0;
+    }
+
+private:
+    struct worker
+    {
+        database db;
+        std::thread thread;
+
+        std::mutex mutex;
+        std::condition_variable job_available;
+        std::deque<job_type> jobs;
+        std::atomic<size_t> pending{ 0 };
+        bool stopping = false;
+    };
+
+    static void run(worker& w);
+    size_t pick_worker() const;
+
+    std::vector<std::unique_ptr<worker>> m_workers;
+};
+
+template <typename Job>
+std::future<typename std::result_of<Job(database&)>::type> async_database::submit(Job&& job)
+{
+    return submit_to(pick_worker(), std::forward<Job>(job));
+}
+
+template <typename Job>
+std::future<typename std::result_of<Job(database&)>::type> async_database::submit_to(size_t worker, Job&& job)
+{
+    typedef typename std::result_of<Job(database&)>::type result_type;
+
+    // std::function needs something copyable
+    auto task = std::make_shared<std::packaged_task<result_type(database&)>>(std::forward<Job>(job));
+    auto result = task->get_future();
+
+    post_to(worker, [task](database& db) { (*task)(db); });
+
+    return result;
+}
+
+} // sqlitepp
+
+#endif // SQLITEPP_ASYNC_H
@@ -0,0 +1,82 @@
+#ifndef SQLITEPP_BLOB_H
+#define SQLITEPP_BLOB_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "sqlite3_inc.h"
+
+namespace sqlitepp
+{
+
+// incremental I/O on a single blob, without loading the whole value
+class blob_stream
+{
+public:
+    blob_stream() noexcept = default;
+    blob_stream(blob_stream&&) noexcept;
+    blob_stream(const blob_stream&) = delete;
+    blob_stream& operator=(blob_stream&&) noexcept;
+    blob_stream& operator=(const blob_stream&) = delete;
+    ~blob_stream();
+
+    int read(void* buffer, size_t length, size_t offset) const;
+    int write(const void* buffer, size_t length, size_t offset);
+
+    // reads the blob 'chunk_size' bytes at a time through a single buffer,
+    // 'callback(const void* data, size_t length)' returns false to stop early
+    template <typename Callback>
+    int read_chunks(size_t chunk_size, Callback callback) const;
+
+    // moves to the same column of another row, cheaper than opening a new stream
+    int reopen(int64_t rowid);
+
+    size_t size() const;
+
+    int close();
+
+    bool ok() const
+    {
+        return m_handle != nullptr;
+    }
+
+private:
+    sqlite3_blob* m_handle = nullptr;
+
+    friend class database;
+};
+
+template <typename Callback>
+int blob_stream::read_chunks(size_t chunk_size, Callback callback) const
+{
+    if ((m_handle == nullptr) || (chunk_size == 0))
+    {
+        return SQLITE_MISUSE;
+    }
+
+    const auto total = size();
+    std::vector<char> buffer((chunk_size < total) ? chunk_size : total);
+
+    for (size_t offset = 0; offset < total; offset += buffer.size())
+    {
+        const auto length = ((total - offset) < buffer.size()) ? (total - offset) : buffer.size();
+
+        const auto code = read(buffer.data(), length, offset);
+        if (code != SQLITE_OK)
+        {
+            return code;
+        }
+
+        if (!callback(static_cast<const void*>(buffer.data()), length))
+        {
+            break;
+        }
+    }
+
+    return SQLITE_OK;
+}
+
+} // sqlitepp
+
+#endif // SQLITEPP_BLOB_H
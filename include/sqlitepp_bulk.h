@@ -0,0 +1,135 @@
+#ifndef SQLITEPP_BULK_H
+#define SQLITEPP_BULK_H
+
+#include <array>
+#include <string>
+#include <vector>
+#include <utility>
+#include <iterator>
+
+#include "sqlite3_inc.h"
+#include "sqlitepp_db.h"
+
+namespace sqlitepp
+{
+
+namespace detail
+{
+    // INSERT INTO table (columns...) VALUES (?,...),(?,...),...
+    std::string make_insert_sql(const char* table, const char* const* columns, size_t column_count, size_t rows);
+
+    // rows per statement, largest first, so that rows * columns stays below 'max_variables'
+    std::vector<size_t> make_batch_sizes(size_t column_count, size_t max_variables);
+}
+
+template <size_t Columns>
+class bulk_insert
+{
+    static_assert(Columns > 0, "An insert needs at least one column.");
+
+public:
+    bulk_insert(const database& db, const char* table, const std::array<const char*, Columns>& columns);
+    bulk_insert(bulk_insert&&) noexcept = default;
+    bulk_insert(const bulk_insert&) = delete;
+    bulk_insert& operator=(bulk_insert&&) noexcept = default;
+    bulk_insert& operator=(const bulk_insert&) = delete;
+
+    template <typename Range>
+    int insert(const Range& rows);
+    template <typename Iterator>
+    int insert(Iterator first, Iterator last);
+
+    bool ok() const
+    {
+        return m_status == SQLITE_OK;
+    }
+
+    int status() const
+    {
+        return m_status;
+    }
+
+private:
+    std::vector<std::pair<size_t, statement>> m_batches;
+    int m_status = SQLITE_OK;
+};
+
+template <size_t Columns>
+bulk_insert<Columns>::bulk_insert(const database& db, const char* table, const std::array<const char*, Columns>& columns)
+{
+    const auto max_variables = db.get_limit(SQLITE_LIMIT_VARIABLE_NUMBER);
+
+    for (const auto rows : detail::make_batch_sizes(Columns, (size_t)max_variables))
+    {
+        const auto sql = detail::make_insert_sql(table, columns.data(), Columns, rows);
+
+        statement stmt = db.prepare(sql.c_str());
+        if (!stmt.ok())
+        {
+            m_status = db.get_last_error();
+            m_batches.clear();
+            return;
+        }
+
+        m_batches.emplace_back(rows, std::move(stmt));
+    }
+}
+
+template <size_t Columns>
+template <typename Range>
+int bulk_insert<Columns>::insert(const Range& rows)
+{
+    return insert(std::begin(rows), std::end(rows));
+}
+
+template <size_t Columns>
+template <typename Iterator>
+int bulk_insert<Columns>::insert(Iterator first, Iterator last)
+{
+    typedef typename std::decay<decltype(*first)>::type row_type;
+    static_assert(std::tuple_size<row_type>::value == Columns,
+        "Each row must have exactly one value per column.");
+
+    if (!ok())
+    {
+        return m_status;
+    }
+
+    auto remaining = (size_t)std::distance(first, last);
+    auto batch = m_batches.begin();
+
+    while (remaining > 0)
+    {
+        // use the largest statement that still fits, the tail goes through smaller ones
+        while (batch->first > remaining)
+        {
+            ++batch;
+        }
+
+        auto& stmt = batch->second;
+        stmt.reset();
+
+        for (size_t row = 0; row < batch->first; ++row, ++first)
+        {
+            const auto code = stmt.bind_tuple(*first, (int)(row * Columns));
+            if (code != SQLITE_OK)
+            {
+                return code;
+            }
+        }
+
+        const auto code = stmt.execute();
+        if (code != SQLITE_OK)
+        {
+            return code;
+        }
+
+        remaining -= batch->first;
+    }
+
+    return SQLITE_OK;
+}
+
+} // sqlitepp
+
+#endif // SQLITEPP_BULK_H
@@ -0,0 +1,179 @@
+#ifndef SQLITEPP_CACHE_H
+#define SQLITEPP_CACHE_H
+
+#include <list>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+
+#include "sqlite3_inc.h"
+#include "sqlitepp_stmt.h"
+
+namespace sqlitepp
+{
+
+class statement_cache;
+
+namespace detail
+{
+    // non-owning view over the query text, used as lookup key
+    // so a cache hit doesn't need to allocate a std::string
+    struct sql_key
+    {
+        const char* text;
+        size_t length;
+    };
+
+    struct sql_key_hash
+    {
+        size_t operator()(const sql_key& key) const noexcept;
+    };
+
+    struct sql_key_equal
+    {
+        bool operator()(const sql_key& lhs, const sql_key& rhs) const noexcept
+        {
+            return (lhs.length == rhs.length) &&
+                   (memcmp(lhs.text, rhs.text, lhs.length) == 0);
+        }
+    };
+
+    struct cache_entry
+    {
+        cache_entry(std::string&& sql, statement&& stmt) noexcept
+            : sql(std::move(sql)),
+            stmt(std::move(stmt))
+        {
+        }
+
+        std::string sql;
+        statement stmt;
+        bool in_use = false;
+        bool detached = false; // not owned by the cache, dies with the lease
+    };
+}
+
+struct cache_stats
+{
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+};
+
+// a lease on a cached statement; it keeps the cache alive, and a database destroyed
+// while leases are out leaves its connection to SQLite until the last one is released
+class cached_statement
+{
+public:
+    cached_statement() noexcept = default;
+    cached_statement(cached_statement&&) noexcept;
+    cached_statement(const cached_statement&) = delete;
+    cached_statement& operator=(cached_statement&&) noexcept;
+    cached_statement& operator=(const cached_statement&) = delete;
+    ~cached_statement();
+
+    statement& operator*() const noexcept
+    {
+        return m_entry->stmt;
+    }
+
+    statement* operator->() const noexcept
+    {
+        return &m_entry->stmt;
+    }
+
+    statement& get() const noexcept
+    {
+        return m_entry->stmt;
+    }
+
+    // hands the statement back to the cache before going out of scope
+    void release();
+
+    bool ok() const
+    {
+        return (m_entry != nullptr) && m_entry->stmt.ok();
+    }
+
+private:
+    cached_statement(std::shared_ptr<statement_cache> cache, detail::cache_entry* entry) noexcept
+        : m_cache(std::move(cache)),
+        m_entry(entry)
+    {
+    }
+
+    std::shared_ptr<statement_cache> m_cache;
+    detail::cache_entry* m_entry = nullptr;
+
+    friend class statement_cache;
+};
+
+class statement_cache
+    : public std::enable_shared_from_this<statement_cache>
+{
+public:
+    static constexpr size_t default_capacity = 32;
+
+    explicit statement_cache(sqlite3* handle, size_t capacity = default_capacity) noexcept;
+    statement_cache(const statement_cache&) = delete;
+    statement_cache& operator=(const statement_cache&) = delete;
+    ~statement_cache();
+
+    cached_statement acquire(const char* query);
+
+    void clear();
+
+    void set_capacity(size_t capacity);
+    size_t get_capacity() const
+    {
+        return m_capacity;
+    }
+
+    size_t get_size() const
+    {
+        return m_lookup.size();
+    }
+
+    // statements handed out and not yet released
+    size_t get_leases() const
+    {
+        return m_leases;
+    }
+
+    const cache_stats& get_stats() const
+    {
+        return m_stats;
+    }
+
+    void reset_stats()
+    {
+        m_stats = cache_stats();
+    }
+
+private:
+    typedef std::list<detail::cache_entry> entry_list;
+    typedef std::unordered_map<detail::sql_key, entry_list::iterator,
+        detail::sql_key_hash, detail::sql_key_equal> entry_lookup;
+
+    int prepare(const char* query, size_t length, statement& stmt) const;
+    void release(detail::cache_entry* entry);
+    void evict();
+
+    sqlite3* m_handle = nullptr;
+    size_t m_capacity = default_capacity;
+    size_t m_leases = 0;
+
+    // most recently used entries are at the front
+    entry_list m_entries;
+    entry_lookup m_lookup;
+
+    cache_stats m_stats;
+
+    friend class cached_statement;
+};
+
+} // sqlitepp
+
+#endif // SQLITEPP_CACHE_H
@@ -0,0 +1,107 @@
+#ifndef SQLITEPP_COLLECTOR_H
+#define SQLITEPP_COLLECTOR_H
+
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+
+#include "sqlite3_inc.h"
+
+namespace sqlitepp
+{
+
+namespace detail
+{
+    // what a trace hook collects on one connection: a Slot per SQL text, merged by the
+    // collector under the mutex, and a State per statement for the connection's own use
+    template <typename Slot, typename State>
+    struct connection_slots
+    {
+        // created the first time the query shows up
+        Slot& slot(const char* sql)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            auto& owned = by_sql[sql];
+            if (!owned)
+            {
+                owned.reset(new Slot(sql));
+            }
+
+            return *owned;
+        }
+
+        // statement handles get reused after finalize, so 'sql' is checked against the state's slot;
+        // the second result tells whether the state was (re)started for it
+        std::pair<State*, bool> state(sqlite3_stmt* stmt, const char* sql)
+        {
+            auto& state = by_stmt[stmt];
+            if ((state.slot != nullptr) && (state.slot->sql() == sql))
+            {
+                return std::make_pair(&state, false);
+            }
+
+            state = State();
+            state.slot = &slot(sql);
+
+            return std::make_pair(&state, true);
+        }
+
+        State* find(sqlite3_stmt* stmt)
+        {
+            const auto it = by_stmt.find(stmt);
+            return (it != by_stmt.end()) ? &it->second : nullptr;
+        }
+
+        void forget(sqlite3_stmt* stmt)
+        {
+            by_stmt.erase(stmt);
+        }
+
+        std::mutex mutex;
+        std::unordered_map<std::string, std::unique_ptr<Slot>> by_sql;
+
+        // only used by the owning connection
+        std::unordered_map<sqlite3_stmt*, State> by_stmt;
+    };
+
+    // the connections a collector is attached to, they live as long as the collector
+    template <typename Connection>
+    class connection_list
+    {
+    public:
+        Connection* attach()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_connections.emplace_back(new Connection());
+            return m_connections.back().get();
+        }
+
+        // callback(const std::string& sql, const Slot& slot) for every slot of every connection
+        template <typename Callback>
+        void for_each_slot(Callback callback) const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const auto& connection : m_connections)
+            {
+                std::lock_guard<std::mutex> connection_lock(connection->mutex);
+                for (const auto& slot : connection->by_sql)
+                {
+                    callback(slot.first, *slot.second);
+                }
+            }
+        }
+
+    private:
+        mutable std::mutex m_mutex;
+        std::vector<std::unique_ptr<Connection>> m_connections;
+    };
+}
+
+} // sqlitepp
+
+#endif // SQLITEPP_COLLECTOR_H
@@ -0,0 +1,35 @@
+#ifndef SQLITEPP_CONFIG_H
+#define SQLITEPP_CONFIG_H
+
+#include "sqlite3_inc.h"
+
+namespace sqlitepp
+{
+
+// process wide sqlite3_config settings, only accepted before sqlite3_initialize()
+// (or the first database is opened) or after shutdown(), SQLITE_MISUSE otherwise
+class global_config
+{
+public:
+    global_config() = delete;
+
+    static int initialize();
+    static int shutdown();
+
+    static int set_allocator(const sqlite3_mem_methods& methods);
+    static int get_allocator(sqlite3_mem_methods& methods);
+
+    // memory statistics serialize every allocation on a global mutex
+    static int set_memory_status(bool enabled);
+
+    // page cache slots, 'buffer' holds 'pages' slots of 'page_size' bytes (page plus header)
+    static int set_page_cache(void* buffer, int page_size, int pages);
+    // fixed heap for the memsys5 allocator, needs SQLITE_ENABLE_MEMSYS5
+    static int set_heap(void* buffer, int size, int min_allocation);
+    // default lookaside size for new connections
+    static int set_lookaside(int slot_size, int slots);
+};
+
+} // sqlitepp
+
+#endif // SQLITEPP_CONFIG_H
@@ -0,0 +1,322 @@
+#ifndef SQLITEPP_CORO_H
+#define SQLITEPP_CORO_H
+
+// optional C++20 layer, the rest of the library stays on C++11
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define SQLITEPP_HAS_COROUTINES
+#endif
+#endif
+
+#ifdef SQLITEPP_HAS_COROUTINES
+
+#include <mutex>
+#include <tuple>
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+#include <coroutine>
+#include <functional>
+
+#include "sqlite3_inc.h"
+#include "sqlitepp_async.h"
+
+namespace sqlitepp
+{
+
+// streams decoded rows of a query that runs on one async_database worker,
+// batches are stepped in the background while the consumer works on the previous one:
+//
+//     row_stream<int64_t, std::string> rows(adb, 0, "SELECT id, name FROM users");
+//     for (;;)
+//     {
+//         const bool more = co_await rows.next();  // not in the condition, GCC 12 miscompiles that
+//         if (!more)
+//             break;
+//         use(rows.row());
+//     }
+//
+// the consumer resumes on the worker thread, the stream has to be
+// destroyed before the async_database is closed
+template <typename... Ts>
+class row_stream
+{
+    static_assert((!std::is_same<Ts, text_view>::value && ...) &&
+                  (!std::is_same<Ts, blob_view>::value && ...),
+        "Views point into the statement's current row, they can't outlive a batch.");
+
+public:
+    typedef std::tuple<Ts...> value_type;
+    typedef std::function<int(statement&)> binder_type;
+
+    class next_awaiter;
+
+    row_stream(async_database& db, size_t worker, std::string query,
+               binder_type binder = binder_type(), size_t batch_size = 256);
+    row_stream(row_stream&&) noexcept = default;
+    row_stream(const row_stream&) = delete;
+    row_stream& operator=(row_stream&&) noexcept = default;
+    row_stream& operator=(const row_stream&) = delete;
+    ~row_stream();
+
+    // resolves to false once the rows are exhausted or an error stopped the query
+    next_awaiter next()
+    {
+        return next_awaiter(m_state.get());
+    }
+
+    const value_type& row() const
+    {
+        return m_state->front[m_state->position];
+    }
+
+    // SQLITE_OK when the stream ended at SQLITE_DONE
+    int status() const
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        return m_state->status;
+    }
+
+private:
+    enum class advance_result
+    {
+        row,
+        end,
+        wait
+    };
+
+    struct state
+        : std::enable_shared_from_this<state>
+    {
+        async_database* db = nullptr;
+        size_t worker = 0;
+        std::string query;
+        binder_type binder;
+        size_t batch_size = 0;
+
+        // only touched on the worker thread
+        cached_statement stmt;
+        bool prepared = false;
+
+        // consumer side
+        std::vector<value_type> front;
+        size_t position = 0;
+        size_t next = 0;
+
+        // handed over under the mutex
+        std::mutex mutex;
+        std::vector<value_type> back;
+        bool fetching = false;
+        bool back_ready = false;
+        bool finished = false;
+        int status = SQLITE_OK;
+        std::coroutine_handle<> waiter;
+    };
+
+    static int fetch(const std::shared_ptr<state>& s);
+    static void fill(state& s, database& db);
+    static advance_result advance(state& s);
+
+    std::shared_ptr<state> m_state;
+
+public:
+    class next_awaiter
+    {
+    public:
+        bool await_ready()
+        {
+            m_result = advance(*m_state);
+            return m_result != advance_result::wait;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            std::lock_guard<std::mutex> lock(m_state->mutex);
+            if (m_state->back_ready)
+            {
+                // the batch landed in the meantime
+                return false;
+            }
+
+            m_state->waiter = handle;
+            return true;
+        }
+
+        bool await_resume()
+        {
+            if (m_result == advance_result::wait)
+            {
+                m_result = advance(*m_state);
+            }
+
+            return m_result == advance_result::row;
+        }
+
+    private:
+        explicit next_awaiter(state* s) noexcept
+            : m_state(s)
+        {
+        }
+
+        state* m_state;
+        advance_result m_result = advance_result::wait;
+
+        friend class row_stream;
+    };
+};
+
+template <typename... Ts>
+row_stream<Ts...>::row_stream(async_database& db, size_t worker, std::string query,
+                              binder_type binder, size_t batch_size)
+    : m_state(std::make_shared<state>())
+{
+    m_state->db = &db;
+    m_state->worker = worker;
+    m_state->query = std::move(query);
+    m_state->binder = std::move(binder);
+    m_state->batch_size = (batch_size > 0) ? batch_size : 1;
+
+    // the first batch is on its way before anyone awaits it
+    m_state->fetching = true;
+
+    const auto code = fetch(m_state);
+    if (code != SQLITE_OK)
+    {
+        m_state->fetching = false;
+        m_state->finished = true;
+        m_state->status = code;
+    }
+}
+
+template <typename... Ts>
+row_stream<Ts...>::~row_stream()
+{
+    if (m_state)
+    {
+        // the cached statement has to go back on the thread that owns its connection
+        auto s = m_state;
+        s->db->post_to(s->worker, [s](database&) { s->stmt.release(); });
+    }
+}
+
+template <typename... Ts>
+int row_stream<Ts...>::fetch(const std::shared_ptr<state>& s)
+{
+    return s->db->post_to(s->worker, [s](database& db)
+    {
+        fill(*s, db);
+
+        std::coroutine_handle<> waiter;
+        {
+            std::lock_guard<std::mutex> lock(s->mutex);
+            s->fetching = false;
+            s->back_ready = true;
+
+            std::swap(waiter, s->waiter);
+        }
+
+        if (waiter)
+        {
+            waiter.resume();
+        }
+    });
+}
+
+template <typename... Ts>
+void row_stream<Ts...>::fill(state& s, database& db)
+{
+    int status = SQLITE_OK;
+    bool finished = false;
+
+    if (!s.prepared)
+    {
+        s.prepared = true;
+        s.stmt = db.prepare_cached(s.query.c_str());
+
+        if (!s.stmt.ok())
+        {
+            status = db.get_last_error();
+        }
+        else if (s.binder)
+        {
+            status = s.binder(*s.stmt);
+        }
+    }
+
+    s.back.clear();
+    while ((status == SQLITE_OK) && (s.back.size() < s.batch_size))
+    {
+        status = s.stmt->execute();
+        if ((status != SQLITE_OK) || (s.stmt->execution_status() != SQLITE_ROW))
+        {
+            break;
+        }
+
+        s.back.emplace_back();
+        status = s.stmt->read_tuple(s.back.back());
+        if (status != SQLITE_OK)
+        {
+            s.back.pop_back();
+        }
+    }
+
+    if ((status != SQLITE_OK) || (s.back.size() < s.batch_size))
+    {
+        finished = true;
+        s.stmt.release();
+    }
+
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.status = status;
+    s.finished = finished;
+}
+
+template <typename... Ts>
+typename row_stream<Ts...>::advance_result row_stream<Ts...>::advance(state& s)
+{
+    if (s.next < s.front.size())
+    {
+        s.position = s.next++;
+        return advance_result::row;
+    }
+
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (!s.back_ready)
+    {
+        return s.fetching ? advance_result::wait : advance_result::end;
+    }
+
+    std::swap(s.front, s.back);
+    s.back_ready = false;
+    s.position = 0;
+    s.next = 0;
+
+    // step the next batch while this one is consumed
+    if (!s.finished)
+    {
+        s.fetching = true;
+
+        const auto code = fetch(s.shared_from_this());
+        if (code != SQLITE_OK)
+        {
+            s.fetching = false;
+            s.finished = true;
+            s.status = code;
+        }
+    }
+
+    if (s.front.empty())
+    {
+        return advance_result::end;
+    }
+
+    s.next = 1;
+    return advance_result::row;
+}
+
+} // sqlitepp
+
+#endif // SQLITEPP_HAS_COROUTINES
+
+#endif // SQLITEPP_CORO_H
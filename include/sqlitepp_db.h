@@ -7,10 +7,36 @@
 
 #include "sqlite3_inc.h"
 #include "sqlitepp_stmt.h"
+#include "sqlitepp_cache.h"
+#include "sqlitepp_blob.h"
+#include "sqlitepp_script.h"
+#include "sqlitepp_sql.h"
+#include "sqlitepp_function.h"
+#include "sqlitepp_vtab.h"
+#include "sqlitepp_profile.h"
+#include "sqlitepp_stats.h"
 
 namespace sqlitepp
 {
 
+namespace detail
+{
+    // context of the sqlite3_trace_v2 callback
+    struct trace_hooks
+    {
+        // null while disabled
+        connection_profile* profile = nullptr;
+        connection_stats* stats = nullptr;
+
+        // where the connection is attached, kept while disabled so enabling
+        // the same collector again doesn't attach another connection to it
+        const query_profiler* profiler = nullptr;
+        connection_profile* attached_profile = nullptr;
+        const stats_registry* registry = nullptr;
+        connection_stats* attached_stats = nullptr;
+    };
+}
+
 class database
 {
 public:
@@ -27,31 +53,256 @@ public:
 
     int open(const char* db, int flags);
     int open(const std::string& db, int flags);
+
+    // SQLITE_BUSY while statements from prepare_cached are still leased; destroying the
+    // database instead leaves the connection open until the last lease is released
     int close();
 
     template <typename... Args>
-    statement prepare(const char* query, const Args&... args) const;
+    statement prepare(const char* query, Args&&... args) const;
     statement prepare(const char* query) const;
+    // fails to compile unless every parameter gets an argument, bound at fixed indices
+    template <size_t Parameters, int Columns, typename... Args>
+    statement prepare(const sql_literal<Parameters, Columns>& query, Args&&... args) const;
     int execute(const char* query) const;
 
+    template <typename... Args>
+    cached_statement prepare_cached(const char* query, Args&&... args) const;
+    cached_statement prepare_cached(const char* query) const;
+    int execute_cached(const char* query) const;
+    statement_cache* get_statement_cache() const;
+
+    // runs every statement of 'sql' through prepare/step instead of sqlite3_exec
+    int execute_script(const char* sql) const;
+    // keeps the prepared statements for repeated runs, e.g. migrations or maintenance batches
+    script compile_script(const char* sql) const;
+
+    blob_stream open_blob(const char* table, const char* column, int64_t rowid, bool writable = false) const;
+    blob_stream open_blob(const char* db, const char* table, const char* column, int64_t rowid, bool writable = false) const;
+
+    // inside an open transaction the rows go into a savepoint and the commit interval is ignored
+    template <typename Range>
+    int insert_many(const char* query, const Range& rows, size_t commit_interval = 0) const;
+    template <typename Range, typename Binder>
+    typename std::enable_if<!std::is_integral<Binder>::value, int>::type
+        insert_many(const char* query, const Range& rows, Binder binder, size_t commit_interval = 0) const;
+
+    // argument and result types are deduced from the callable, which is kept until the function is dropped;
+    // a NULL argument gives a NULL result, exceptions become the query's error
+    template <typename F>
+    int create_function(const char* name, F&& function, bool deterministic = false);
+
+    // State is default constructible and provides step(args...) and value();
+    // window functions additionally need inverse(args...); rows with NULL arguments are skipped
+    template <typename State>
+    int create_aggregate(const char* name, bool deterministic = false);
+
+    template <typename State>
+    int create_window_function(const char* name, bool deterministic = false);
+
+    // eponymous virtual table named after the module, e.g. "SELECT * FROM name"
+    template <typename T>
+    int create_module(const char* name, vector_table<T> table);
+
+    // table-valued function over a bound std::vector<int64_t> or std::vector<std::string>,
+    // e.g. "SELECT * FROM t WHERE id IN array(?)" with the vector bound to the parameter
+    int create_array_module(const char* name = "array");
+
     int toggle_extended_result_codes();
     bool is_using_extended_result_codes() const;
 
+    int get_last_error() const;
+    int get_limit(int id) const;
+    int set_limit(int id, int value);
+
+    int set_busy_timeout(int milliseconds);
+
+    // per query latency histograms through sqlite3_trace_v2, nothing is hooked while disabled
+    int enable_profiling(query_profiler& profiler);
+    int disable_profiling();
+
+    // sqlite3_stmt_status counters of every statement run, collected the same way
+    int enable_statement_stats(stats_registry& registry);
+    int disable_statement_stats();
+
 private:
     sqlite3* m_handle = nullptr;
     bool m_extended_result_codes = false;
 
+    // kept on the heap so leased statements survive moving the database
+    // shared with the leases handed out by prepare_cached
+    std::shared_ptr<statement_cache> m_cache;
+
+    // trace callback context, heap allocated for the same reason
+    std::unique_ptr<detail::trace_hooks> m_trace;
+
+    int update_trace();
+
 }; // database
 
 template <typename... Args>
-statement database::prepare(const char* query, const Args&... args) const
+statement database::prepare(const char* query, Args&&... args) const
 {
     statement stmt = prepare(query);
-    stmt.bind(args...);
+    stmt.bind(std::forward<Args>(args)...);
+
+    return stmt;
+}
+
+template <size_t Parameters, int Columns, typename... Args>
+statement database::prepare(const sql_literal<Parameters, Columns>& query, Args&&... args) const
+{
+    static_assert((sizeof...(Args) == 0) || (sizeof...(Args) == Parameters),
+        "The number of arguments doesn't match the parameters in the query. "
+        "Pass 'skip_arg' for parameters that are bound later.");
+
+    statement stmt = prepare(query.text);
+    if (sizeof...(Args) != 0)
+    {
+        detail::bind_fixed<1>(stmt, std::forward<Args>(args)...);
+        stmt.m_bind_index = (int)sizeof...(Args);
+    }
+
+    return stmt;
+}
+
+template <typename... Args>
+cached_statement database::prepare_cached(const char* query, Args&&... args) const
+{
+    cached_statement stmt = prepare_cached(query);
+    if (stmt.ok())
+    {
+        stmt->bind(std::forward<Args>(args)...);
+    }
 
     return stmt;
 }
 
+template <typename F>
+int database::create_function(const char* name, F&& function, bool deterministic)
+{
+    typedef typename std::decay<F>::type function_type;
+    typedef detail::function_traits<function_type> traits;
+
+    auto* user_data = new function_type(std::forward<F>(function));
+    const int flags = SQLITE_UTF8 | (deterministic ? SQLITE_DETERMINISTIC : 0);
+
+    // SQLite calls the destructor itself when registration fails
+    return sqlite3_create_function_v2(m_handle, name, (int)traits::arity, flags, user_data,
+        &detail::scalar_function<function_type>, nullptr, nullptr,
+        &detail::destroy_user_data<function_type>);
+}
+
+template <typename State>
+int database::create_aggregate(const char* name, bool deterministic)
+{
+    typedef detail::function_traits<decltype(&State::step)> traits;
+
+    const int flags = SQLITE_UTF8 | (deterministic ? SQLITE_DETERMINISTIC : 0);
+    return sqlite3_create_function_v2(m_handle, name, (int)traits::arity, flags, nullptr,
+        nullptr, &detail::aggregate_step<State>, &detail::aggregate_final<State>, nullptr);
+}
+
+template <typename State>
+int database::create_window_function(const char* name, bool deterministic)
+{
+    typedef detail::function_traits<decltype(&State::step)> traits;
+
+    const int flags = SQLITE_UTF8 | (deterministic ? SQLITE_DETERMINISTIC : 0);
+    return sqlite3_create_window_function(m_handle, name, (int)traits::arity, flags, nullptr,
+        &detail::aggregate_step<State>, &detail::aggregate_final<State>,
+        &detail::aggregate_value<State>, &detail::aggregate_inverse<State>, nullptr);
+}
+
+template <typename T>
+int database::create_module(const char* name, vector_table<T> table)
+{
+    auto* user_data = new vector_table<T>(std::move(table));
+
+    // SQLite calls the destructor itself when registration fails
+    return sqlite3_create_module_v2(m_handle, name, detail::vector_vtab<T>::get(), user_data,
+        &detail::destroy_user_data<vector_table<T>>);
+}
+
+template <typename Range>
+int database::insert_many(const char* query, const Range& rows, size_t commit_interval) const
+{
+    return insert_many(query, rows, detail::tuple_row_binder(), commit_interval);
+}
+
+template <typename Range, typename Binder>
+typename std::enable_if<!std::is_integral<Binder>::value, int>::type
+    database::insert_many(const char* query, const Range& rows, Binder binder, size_t commit_interval) const
+{
+    cached_statement stmt = prepare_cached(query);
+    if (!stmt.ok())
+    {
+        return get_last_error();
+    }
+
+    // the caller's transaction must survive both success and failure,
+    // so nested batches run in a savepoint and only it is rolled back
+    const bool nested = (sqlite3_get_autocommit(m_handle) == 0);
+    if (nested)
+    {
+        commit_interval = 0;
+    }
+
+    // IMMEDIATE takes the write lock up front instead of failing on upgrade
+    auto code = execute_cached(nested ? "SAVEPOINT sqlitepp_insert_many" : "BEGIN IMMEDIATE");
+    if (code != SQLITE_OK)
+    {
+        return code;
+    }
+
+    // a commit interval of 0 keeps everything in a single transaction,
+    // on failure only the rows since the last commit are rolled back
+    size_t pending = 0;
+    for (const auto& row : rows)
+    {
+        stmt->reset();
+
+        code = binder(*stmt, row);
+        if (code == SQLITE_OK)
+        {
+            code = stmt->execute();
+        }
+
+        if ((code == SQLITE_OK) &&
+            (commit_interval != 0) &&
+            (++pending == commit_interval))
+        {
+            pending = 0;
+
+            code = execute_cached("COMMIT");
+            if (code == SQLITE_OK)
+            {
+                code = execute_cached("BEGIN IMMEDIATE");
+            }
+        }
+
+        if (code != SQLITE_OK)
+        {
+            stmt->reset();
+
+            if (nested)
+            {
+                execute_cached("ROLLBACK TO sqlitepp_insert_many");
+                execute_cached("RELEASE sqlitepp_insert_many");
+            }
+            else
+            {
+                execute_cached("ROLLBACK");
+            }
+
+            return code;
+        }
+    }
+
+    stmt->reset();
+    return execute_cached(nested ? "RELEASE sqlitepp_insert_many" : "COMMIT");
+}
+
 } // sqlitepp
 
 #endif // SQLITEPP_DATABASE_H
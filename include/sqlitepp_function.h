@@ -0,0 +1,334 @@
+#ifndef SQLITEPP_FUNCTION_H
+#define SQLITEPP_FUNCTION_H
+
+#include <tuple>
+#include <string>
+#include <vector>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "sqlite3_inc.h"
+#include "sqlitepp_stmt.h"
+
+namespace sqlitepp
+{
+
+namespace detail
+{
+    template <size_t... I>
+    struct index_sequence
+    {
+    };
+
+    template <size_t N, size_t... I>
+    struct make_index_sequence
+        : make_index_sequence<N - 1, N - 1, I...>
+    {
+    };
+
+    template <size_t... I>
+    struct make_index_sequence<0, I...>
+        : index_sequence<I...>
+    {
+    };
+
+    // argument and result types of a callable
+    template <typename F>
+    struct function_traits
+        : function_traits<decltype(&F::operator())>
+    {
+    };
+
+    template <typename R, typename... Args>
+    struct function_traits<R(*)(Args...)>
+    {
+        typedef R result_type;
+        typedef std::tuple<typename std::decay<Args>::type...> arguments_type;
+
+        static constexpr size_t arity = sizeof...(Args);
+    };
+
+    template <typename R, typename... Args>
+    struct function_traits<R(Args...)>
+        : function_traits<R(*)(Args...)>
+    {
+    };
+
+    template <typename C, typename R, typename... Args>
+    struct function_traits<R(C::*)(Args...)>
+        : function_traits<R(*)(Args...)>
+    {
+    };
+
+    template <typename C, typename R, typename... Args>
+    struct function_traits<R(C::*)(Args...) const>
+        : function_traits<R(*)(Args...)>
+    {
+    };
+
+    // same type set as read(), from function arguments instead of columns
+    int read_value(sqlite3_value* value, int32_t& result);
+    int read_value(sqlite3_value* value, int64_t& result);
+    int read_value(sqlite3_value* value, double& result);
+    int read_value(sqlite3_value* value, std::string& result);
+    int read_value(sqlite3_value* value, std::vector<char>& result);
+    int read_value(sqlite3_value* value, text_view& result);
+    int read_value(sqlite3_value* value, blob_view& result);
+
+    inline int read_value(sqlite3_value*, skip_arg&)
+    {
+        return SQLITE_OK;
+    }
+
+    // text and blobs are copied by SQLite, views may point into the arguments
+    void set_result(sqlite3_context* context, std::nullptr_t);
+    void set_result(sqlite3_context* context, int32_t value);
+    void set_result(sqlite3_context* context, int64_t value);
+    void set_result(sqlite3_context* context, double value);
+    void set_result(sqlite3_context* context, const char* value);
+    void set_result(sqlite3_context* context, const std::string& value);
+    void set_result(sqlite3_context* context, const std::vector<char>& value);
+    void set_result(sqlite3_context* context, const text_view& value);
+    void set_result(sqlite3_context* context, const blob_view& value);
+
+    template <size_t I, size_t N>
+    struct tuple_value_reader
+    {
+        template <typename Tuple>
+        static int apply(sqlite3_value** values, Tuple& result)
+        {
+            const auto code = read_value(values[I], std::get<I>(result));
+            return (code == SQLITE_OK)
+                ? tuple_value_reader<I + 1, N>::apply(values, result)
+                : code;
+        }
+    };
+
+    template <size_t N>
+    struct tuple_value_reader<N, N>
+    {
+        template <typename Tuple>
+        static int apply(sqlite3_value**, Tuple&)
+        {
+            return SQLITE_OK;
+        }
+    };
+
+    template <typename F, typename Tuple, size_t... I>
+    typename std::enable_if<std::is_void<typename function_traits<F>::result_type>::value>::type
+        invoke_function(sqlite3_context* context, F& function, Tuple& arguments, index_sequence<I...>)
+    {
+        function(std::get<I>(arguments)...);
+        sqlite3_result_null(context);
+    }
+
+    template <typename F, typename Tuple, size_t... I>
+    typename std::enable_if<!std::is_void<typename function_traits<F>::result_type>::value>::type
+        invoke_function(sqlite3_context* context, F& function, Tuple& arguments, index_sequence<I...>)
+    {
+        set_result(context, function(std::get<I>(arguments)...));
+    }
+
+    // true when any argument is NULL
+    bool has_null(int argc, sqlite3_value** argv);
+
+    // reports the exception being handled as the function's error; the callbacks
+    // are called from C, so nothing may propagate out of them
+    void result_exception(sqlite3_context* context);
+
+    template <typename F>
+    void scalar_function(sqlite3_context* context, int argc, sqlite3_value** argv)
+    {
+        typedef function_traits<F> traits;
+        typedef typename traits::arguments_type arguments_type;
+
+        if (argc != (int)traits::arity)
+        {
+            sqlite3_result_error_code(context, SQLITE_MISUSE);
+            return;
+        }
+
+        // NULL in, NULL out, like SQLite's own scalar functions
+        if (has_null(argc, argv))
+        {
+            sqlite3_result_null(context);
+            return;
+        }
+
+        auto* function = static_cast<F*>(sqlite3_user_data(context));
+
+        try
+        {
+            // decoded on the stack, no allocation unless an argument type needs one
+            arguments_type arguments;
+            const auto code = tuple_value_reader<0, traits::arity>::apply(argv, arguments);
+            if (code != SQLITE_OK)
+            {
+                sqlite3_result_error_code(context, code);
+                return;
+            }
+
+            invoke_function(context, *function, arguments, make_index_sequence<traits::arity>());
+        }
+        catch (...)
+        {
+            result_exception(context);
+        }
+    }
+
+    // aggregate state lives in sqlite3_aggregate_context memory, which
+    // SQLite zeroes on first use, so `constructed` starts out false
+    template <typename State>
+    struct aggregate_slot
+    {
+        bool constructed;
+        typename std::aligned_storage<sizeof(State), alignof(State)>::type storage;
+
+        State& get()
+        {
+            return *reinterpret_cast<State*>(&storage);
+        }
+    };
+
+    template <typename State>
+    State* aggregate_state(sqlite3_context* context)
+    {
+        static_assert(alignof(aggregate_slot<State>) <= 8,
+            "aggregate state must not need more than 8 byte alignment");
+
+        auto* slot = static_cast<aggregate_slot<State>*>(
+            sqlite3_aggregate_context(context, sizeof(aggregate_slot<State>)));
+        if (slot == nullptr)
+        {
+            sqlite3_result_error_nomem(context);
+            return nullptr;
+        }
+
+        if (!slot->constructed)
+        {
+            new (&slot->storage) State();
+            slot->constructed = true;
+        }
+
+        return &slot->get();
+    }
+
+    template <typename State, typename Method, typename Tuple, size_t... I>
+    void invoke_method(State& state, Method method, Tuple& arguments, index_sequence<I...>)
+    {
+        (state.*method)(std::get<I>(arguments)...);
+    }
+
+    template <typename State, typename Method, Method method>
+    void aggregate_call(sqlite3_context* context, int argc, sqlite3_value** argv)
+    {
+        typedef function_traits<Method> traits;
+        typedef typename traits::arguments_type arguments_type;
+
+        if (argc != (int)traits::arity)
+        {
+            sqlite3_result_error_code(context, SQLITE_MISUSE);
+            return;
+        }
+
+        // rows with NULL arguments are left out, like SQLite's own aggregates do;
+        // step and inverse skip the same rows, so windows stay consistent
+        if (has_null(argc, argv))
+        {
+            return;
+        }
+
+        try
+        {
+            State* state = aggregate_state<State>(context);
+            if (state == nullptr)
+                return;
+
+            arguments_type arguments;
+            const auto code = tuple_value_reader<0, traits::arity>::apply(argv, arguments);
+            if (code != SQLITE_OK)
+            {
+                sqlite3_result_error_code(context, code);
+                return;
+            }
+
+            invoke_method(*state, method, arguments, make_index_sequence<traits::arity>());
+        }
+        catch (...)
+        {
+            result_exception(context);
+        }
+    }
+
+    template <typename State>
+    void aggregate_step(sqlite3_context* context, int argc, sqlite3_value** argv)
+    {
+        aggregate_call<State, decltype(&State::step), &State::step>(context, argc, argv);
+    }
+
+    template <typename State>
+    void aggregate_inverse(sqlite3_context* context, int argc, sqlite3_value** argv)
+    {
+        aggregate_call<State, decltype(&State::inverse), &State::inverse>(context, argc, argv);
+    }
+
+    template <typename State>
+    void aggregate_value(sqlite3_context* context)
+    {
+        try
+        {
+            // a window can be asked for its value before any step
+            State* state = aggregate_state<State>(context);
+            if (state != nullptr)
+            {
+                set_result(context, state->value());
+            }
+        }
+        catch (...)
+        {
+            result_exception(context);
+        }
+    }
+
+    template <typename State>
+    void aggregate_final(sqlite3_context* context)
+    {
+        auto* slot = static_cast<aggregate_slot<State>*>(sqlite3_aggregate_context(context, 0));
+
+        try
+        {
+            if ((slot == nullptr) || !slot->constructed)
+            {
+                // no rows were aggregated
+                State empty;
+                set_result(context, empty.value());
+            }
+            else
+            {
+                set_result(context, slot->get().value());
+            }
+        }
+        catch (...)
+        {
+            result_exception(context);
+        }
+
+        if ((slot != nullptr) && slot->constructed)
+        {
+            slot->get().~State();
+            slot->constructed = false;
+        }
+    }
+
+    template <typename T>
+    void destroy_user_data(void* data)
+    {
+        delete static_cast<T*>(data);
+    }
+}
+
+} // sqlitepp
+
+#endif // SQLITEPP_FUNCTION_H
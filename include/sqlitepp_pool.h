@@ -0,0 +1,189 @@
+#ifndef SQLITEPP_POOL_H
+#define SQLITEPP_POOL_H
+
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <condition_variable>
+
+#include "sqlite3_inc.h"
+#include "sqlitepp_db.h"
+
+namespace sqlitepp
+{
+
+class connection_pool;
+
+class connection_lease
+{
+public:
+    connection_lease() noexcept = default;
+    connection_lease(connection_lease&&) noexcept;
+    connection_lease(const connection_lease&) = delete;
+    connection_lease& operator=(connection_lease&&) noexcept;
+    connection_lease& operator=(const connection_lease&) = delete;
+    ~connection_lease();
+
+    database& operator*() const noexcept
+    {
+        return *m_db;
+    }
+
+    database* operator->() const noexcept
+    {
+        return m_db;
+    }
+
+    database& get() const noexcept
+    {
+        return *m_db;
+    }
+
+    void release();
+
+    bool ok() const
+    {
+        return m_db != nullptr;
+    }
+
+    bool is_writer() const
+    {
+        return m_writer;
+    }
+
+private:
+    connection_lease(connection_pool* pool, database* db, bool writer) noexcept
+        : m_pool(pool),
+        m_db(db),
+        m_writer(writer)
+    {
+    }
+
+    connection_pool* m_pool = nullptr;
+    database* m_db = nullptr;
+    bool m_writer = false;
+
+    friend class connection_pool;
+};
+
+// a cached statement together with the connection it was prepared on
+class pooled_statement
+{
+public:
+    pooled_statement() noexcept = default;
+    pooled_statement(pooled_statement&&) noexcept = default;
+    pooled_statement(const pooled_statement&) = delete;
+    pooled_statement& operator=(pooled_statement&&) noexcept;
+    pooled_statement& operator=(const pooled_statement&) = delete;
+
+    statement& operator*() const noexcept
+    {
+        return *m_stmt;
+    }
+
+    statement* operator->() const noexcept
+    {
+        return &*m_stmt;
+    }
+
+    statement& get() const noexcept
+    {
+        return *m_stmt;
+    }
+
+    database& get_database() const noexcept
+    {
+        return *m_lease;
+    }
+
+    bool ok() const
+    {
+        return m_stmt.ok();
+    }
+
+    bool is_writer() const
+    {
+        return m_lease.is_writer();
+    }
+
+private:
+    pooled_statement(connection_lease&& lease, cached_statement&& stmt) noexcept
+        : m_lease(std::move(lease)),
+        m_stmt(std::move(stmt))
+    {
+    }
+
+    // the statement goes back to its connection's cache before the connection is released
+    connection_lease m_lease;
+    cached_statement m_stmt;
+
+    friend class connection_pool;
+};
+
+// one writer and N read-only connections to the same database in WAL mode,
+// reads scale across threads while writes are serialized on the single writer
+class connection_pool
+{
+public:
+    connection_pool() noexcept = default;
+    connection_pool(const char* db, size_t readers, int& result);
+    connection_pool(const connection_pool&) = delete;
+    connection_pool& operator=(const connection_pool&) = delete;
+    // waits for the outstanding leases to come back first
+    ~connection_pool();
+
+    // SQLITE_BUSY while connections are leased
+    int open(const char* db, size_t readers);
+    int close();
+
+    // block until a connection is free, with no readers the writer is handed out for reads too
+    connection_lease acquire_writer();
+    connection_lease acquire_reader();
+
+    // prepared on a reader, or on the writer when the statement modifies the database
+    template <typename... Args>
+    pooled_statement prepare(const char* query, const Args&... args);
+    pooled_statement prepare(const char* query);
+
+    size_t get_reader_count() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_readers.size();
+    }
+
+private:
+    connection_lease acquire_writer(std::unique_lock<std::mutex>& lock);
+    void release(database* db, bool writer);
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_writer_released;
+    std::condition_variable m_reader_released;
+    std::condition_variable m_all_released;
+
+    // handed out and not yet released, the connections stay open while any are out
+    size_t m_leases = 0;
+
+    std::unique_ptr<database> m_writer;
+    bool m_writer_busy = false;
+
+    std::vector<std::unique_ptr<database>> m_readers;
+    std::vector<database*> m_idle_readers;
+
+    friend class connection_lease;
+};
+
+template <typename... Args>
+pooled_statement connection_pool::prepare(const char* query, const Args&... args)
+{
+    pooled_statement stmt = prepare(query);
+    if (stmt.ok())
+    {
+        stmt->bind(args...);
+    }
+
+    return stmt;
+}
+
+} // sqlitepp
+
+#endif // SQLITEPP_POOL_H
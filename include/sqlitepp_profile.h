@@ -0,0 +1,125 @@
+#ifndef SQLITEPP_PROFILE_H
+#define SQLITEPP_PROFILE_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "sqlite3_inc.h"
+#include "sqlitepp_collector.h"
+
+namespace sqlitepp
+{
+
+struct histogram_snapshot
+{
+    std::vector<uint64_t> buckets;
+    uint64_t count = 0;
+    uint64_t total_ns = 0;
+    uint64_t max_ns = 0;
+
+    // upper bound of the bucket holding the given percentile (0 - 100)
+    uint64_t percentile(double p) const;
+    double mean() const;
+
+    void merge(const histogram_snapshot& other);
+};
+
+// log-linear buckets (8 per power of two, HDR-style) over nanoseconds,
+// written by a single connection and readable from any thread
+class latency_histogram
+{
+public:
+    static constexpr size_t sub_bucket_bits = 3;
+    static constexpr size_t sub_bucket_count = size_t(1) << sub_bucket_bits;
+    static constexpr size_t bucket_count = (64 - sub_bucket_bits + 1) * sub_bucket_count;
+
+    latency_histogram() noexcept;
+    latency_histogram(const latency_histogram&) = delete;
+    latency_histogram& operator=(const latency_histogram&) = delete;
+
+    // single writer only, so plain relaxed stores are enough
+    void record(uint64_t nanoseconds);
+
+    histogram_snapshot snapshot() const;
+
+    static size_t bucket_index(uint64_t value);
+    static uint64_t bucket_upper_bound(size_t index);
+
+private:
+    std::atomic<uint64_t> m_buckets[bucket_count];
+    std::atomic<uint64_t> m_count;
+    std::atomic<uint64_t> m_total_ns;
+    std::atomic<uint64_t> m_max_ns;
+};
+
+struct query_latency
+{
+    std::string sql;
+    histogram_snapshot latency;
+};
+
+namespace detail
+{
+    struct profile_slot
+    {
+        explicit profile_slot(const char* text)
+            : text(text)
+        {
+        }
+
+        const std::string& sql() const
+        {
+            return text;
+        }
+
+        std::string text;
+        latency_histogram latency;
+    };
+
+    // a run between SQLITE_TRACE_STMT and SQLITE_TRACE_PROFILE
+    struct statement_profile
+    {
+        profile_slot* slot = nullptr;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    // histograms of one connection, so recording never contends with other threads
+    struct connection_profile
+        : connection_slots<profile_slot, statement_profile>
+    {
+        // SQLITE_TRACE_STMT and SQLITE_TRACE_PROFILE, SQLite's own estimate only has millisecond resolution
+        void begin(sqlite3_stmt* stmt);
+        void end(sqlite3_stmt* stmt);
+    };
+}
+
+// collects per query latencies from every database it's enabled on,
+// it has to outlive those databases (or their profiling)
+class query_profiler
+{
+public:
+    query_profiler() noexcept = default;
+    query_profiler(const query_profiler&) = delete;
+    query_profiler& operator=(const query_profiler&) = delete;
+
+    // merged over all connections, by SQL text
+    std::vector<query_latency> snapshot() const;
+
+private:
+    detail::connection_profile* attach()
+    {
+        return m_connections.attach();
+    }
+
+    detail::connection_list<detail::connection_profile> m_connections;
+
+    friend class database;
+};
+
+} // sqlitepp
+
+#endif // SQLITEPP_PROFILE_H
@@ -0,0 +1,152 @@
+#ifndef SQLITEPP_SCRIPT_H
+#define SQLITEPP_SCRIPT_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include "sqlite3_inc.h"
+#include "sqlitepp_stmt.h"
+
+namespace sqlitepp
+{
+
+namespace detail
+{
+    struct script_no_binder
+    {
+        int operator()(statement&, size_t) const
+        {
+            return SQLITE_OK;
+        }
+    };
+
+    struct script_no_rows
+    {
+        int operator()(statement&, size_t) const
+        {
+            return SQLITE_OK;
+        }
+    };
+}
+
+// multi-statement SQL text walked through the prepare tail pointer; each
+// statement is prepared right before it first runs, so it can depend on
+// schema created earlier in the same script, and is kept for later runs
+class script
+{
+public:
+    script() noexcept = default;
+    script(script&&) noexcept;
+    script(const script&) = delete;
+    script& operator=(script&&) noexcept;
+    script& operator=(const script&) = delete;
+    ~script() = default;
+
+    // binder(stmt, index) is called before statement 'index' runs and
+    // row_handler(stmt, index) for each of its rows; anything but SQLITE_OK stops the script
+    int run();
+    template <typename Binder>
+    int run(Binder binder);
+    template <typename Binder, typename RowHandler>
+    int run(Binder binder, RowHandler row_handler);
+
+    // statements prepared so far, all of them once the script ran to the end
+    size_t get_statement_count() const
+    {
+        return m_statements.size();
+    }
+
+    bool is_compiled() const
+    {
+        return m_compiled;
+    }
+
+    bool ok() const
+    {
+        return m_handle != nullptr;
+    }
+
+private:
+    script(sqlite3* handle, const char* sql, bool persistent);
+
+    // prepares the statement starting at m_offset, false at the end of the text
+    int prepare_next(bool& found);
+
+    sqlite3* m_handle = nullptr;
+    std::string m_sql;
+    size_t m_offset = 0;
+    bool m_persistent = false;
+    bool m_compiled = false;
+
+    std::vector<statement> m_statements;
+
+    friend class database;
+};
+
+template <typename Binder>
+int script::run(Binder binder)
+{
+    return run(binder, detail::script_no_rows());
+}
+
+template <typename Binder, typename RowHandler>
+int script::run(Binder binder, RowHandler row_handler)
+{
+    if (m_handle == nullptr)
+    {
+        return SQLITE_MISUSE;
+    }
+
+    for (size_t index = 0;; ++index)
+    {
+        if (index == m_statements.size())
+        {
+            if (m_compiled)
+            {
+                return SQLITE_OK;
+            }
+
+            bool found = false;
+            const auto code = prepare_next(found);
+            if (code != SQLITE_OK)
+            {
+                return code;
+            }
+
+            if (!found)
+            {
+                m_compiled = true;
+                return SQLITE_OK;
+            }
+        }
+
+        auto& stmt = m_statements[index];
+        stmt.reset();
+
+        auto code = binder(stmt, index);
+        while (code == SQLITE_OK)
+        {
+            code = stmt.execute();
+            if ((code != SQLITE_OK) || (stmt.execution_status() != SQLITE_ROW))
+            {
+                break;
+            }
+
+            code = row_handler(stmt, index);
+        }
+
+        // don't hold read locks or bound buffers past the statement
+        stmt.reset();
+        stmt.clear_bindings();
+
+        if (code != SQLITE_OK)
+        {
+            return code;
+        }
+    }
+}
+
+} // sqlitepp
+
+#endif // SQLITEPP_SCRIPT_H
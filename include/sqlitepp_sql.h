@@ -0,0 +1,275 @@
+#ifndef SQLITEPP_SQL_H
+#define SQLITEPP_SQL_H
+
+#include <cstddef>
+
+#include "sqlite3_inc.h"
+#include "sqlitepp_stmt.h"
+
+namespace sqlitepp
+{
+
+namespace detail
+{
+    // C++11 constexpr has to recurse; words and whitespace runs are skipped
+    // in one step each, so the depth grows with the token count (compilers
+    // allow about 512 levels by default, -fconstexpr-depth raises it)
+    constexpr bool is_ident(char c)
+    {
+        return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) ||
+               ((c >= '0') && (c <= '9')) || (c == '_') || (c == '$') ||
+               ((unsigned char)c >= 0x80);
+    }
+
+    constexpr bool is_digit(char c)
+    {
+        return (c >= '0') && (c <= '9');
+    }
+
+    constexpr bool is_space(char c)
+    {
+        return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\r') || (c == '\f') || (c == '\v');
+    }
+
+    constexpr bool is_prefix(char c)
+    {
+        return (c == ':') || (c == '@') || (c == '$') || (c == '#');
+    }
+
+    constexpr char to_lower(char c)
+    {
+        return ((c >= 'A') && (c <= 'Z')) ? (char)(c - 'A' + 'a') : c;
+    }
+
+    constexpr size_t max_of(size_t lhs, size_t rhs)
+    {
+        return (lhs > rhs) ? lhs : rhs;
+    }
+
+    constexpr size_t skip_ident(const char* s, size_t i)
+    {
+        return is_ident(s[i]) ? skip_ident(s, i + 1) : i;
+    }
+
+    constexpr size_t skip_digits(const char* s, size_t i)
+    {
+        return is_digit(s[i]) ? skip_digits(s, i + 1) : i;
+    }
+
+    constexpr size_t skip_space(const char* s, size_t i)
+    {
+        return is_space(s[i]) ? skip_space(s, i + 1) : i;
+    }
+
+    // 'i' is just past the opening quote, a doubled quote is an escaped one
+    constexpr size_t skip_quoted(const char* s, size_t i, char quote)
+    {
+        return (s[i] == '\0') ? i
+            : (s[i] != quote) ? skip_quoted(s, i + 1, quote)
+            : (s[i + 1] == quote) ? skip_quoted(s, i + 2, quote)
+            : i + 1;
+    }
+
+    constexpr size_t skip_line_comment(const char* s, size_t i)
+    {
+        return ((s[i] == '\0') || (s[i] == '\n')) ? i : skip_line_comment(s, i + 1);
+    }
+
+    constexpr size_t skip_block_comment(const char* s, size_t i)
+    {
+        return (s[i] == '\0') ? i
+            : ((s[i] == '*') && (s[i + 1] == '/')) ? i + 2
+            : skip_block_comment(s, i + 1);
+    }
+
+    constexpr size_t read_number(const char* s, size_t i, size_t value)
+    {
+        return is_digit(s[i]) ? read_number(s, i + 1, value * 10 + (size_t)(s[i] - '0')) : value;
+    }
+
+    constexpr bool is_quote(char c)
+    {
+        return (c == '\'') || (c == '"') || (c == '`') || (c == '[');
+    }
+
+    constexpr size_t skip_token(const char* s, size_t i)
+    {
+        return (s[i] == '[') ? skip_quoted(s, i + 1, ']')
+            : is_quote(s[i]) ? skip_quoted(s, i + 1, s[i])
+            : ((s[i] == '-') && (s[i + 1] == '-')) ? skip_line_comment(s, i)
+            : ((s[i] == '/') && (s[i + 1] == '*')) ? skip_block_comment(s, i + 2)
+            : is_space(s[i]) ? skip_space(s, i)
+            : is_ident(s[i]) ? skip_ident(s, i)
+            : i + 1;
+    }
+
+    constexpr bool is_special(const char* s, size_t i)
+    {
+        return is_quote(s[i]) || ((s[i] == '-') && (s[i + 1] == '-')) || ((s[i] == '/') && (s[i + 1] == '*'));
+    }
+
+    constexpr size_t skip_tcl_suffix(const char* s, size_t i)
+    {
+        return ((s[i] == '\0') || is_space(s[i])) ? i
+            : (s[i] == ')') ? i + 1
+            : skip_tcl_suffix(s, i + 1);
+    }
+
+    // end of a named parameter, after the prefix SQLite's tokenizer also
+    // takes TCL style "::" separators and a "(...)" suffix into the name
+    constexpr size_t skip_variable(const char* s, size_t i, size_t idents)
+    {
+        return is_ident(s[i]) ? skip_variable(s, i + 1, idents + 1)
+            : ((s[i] == '(') && (idents != 0)) ? skip_tcl_suffix(s, i + 1)
+            : ((s[i] == ':') && (s[i + 1] == ':')) ? skip_variable(s, i + 2, idents)
+            : i;
+    }
+
+    constexpr size_t variable_end(const char* s, size_t i)
+    {
+        return skip_variable(s, i + 1, 0);
+    }
+
+    constexpr bool has_ident(const char* s, size_t i, size_t end)
+    {
+        return (i < end) && (is_ident(s[i]) || has_ident(s, i + 1, end));
+    }
+
+    constexpr bool is_named_parameter(const char* s, size_t i)
+    {
+        return is_prefix(s[i]) && has_ident(s, i + 1, variable_end(s, i));
+    }
+
+    constexpr bool same_text(const char* s, size_t a, size_t b, size_t length)
+    {
+        return (length == 0) || ((s[a] == s[b]) && same_text(s, a + 1, b + 1, length - 1));
+    }
+
+    // named parameters at 'a' and 'b' are the same, prefix included
+    constexpr bool same_variable(const char* s, size_t a, size_t b)
+    {
+        return ((variable_end(s, a) - a) == (variable_end(s, b) - b)) &&
+               same_text(s, a, b, variable_end(s, a) - a);
+    }
+
+    // a named parameter keeps the index of its first occurrence
+    constexpr bool name_seen(const char* s, size_t i, size_t at)
+    {
+        return (i >= at) ? false
+            : is_special(s, i) ? name_seen(s, skip_token(s, i), at)
+            : is_named_parameter(s, i)
+                ? (same_variable(s, i, at) || name_seen(s, variable_end(s, i), at))
+            : name_seen(s, skip_token(s, i), at);
+    }
+
+    // same as sqlite3_bind_parameter_count, the largest parameter index;
+    // only the first statement is prepared, so counting stops at a ';'
+    constexpr size_t count_parameters(const char* s, size_t i = 0, size_t highest = 0)
+    {
+        return ((s[i] == '\0') || (s[i] == ';')) ? highest
+            : is_special(s, i) ? count_parameters(s, skip_token(s, i), highest)
+            : (s[i] == '?') ? (is_digit(s[i + 1])
+                ? count_parameters(s, skip_digits(s, i + 1), max_of(highest, read_number(s, i + 1, 0)))
+                : count_parameters(s, i + 1, highest + 1))
+            : is_named_parameter(s, i)
+                ? count_parameters(s, variable_end(s, i), name_seen(s, 0, i) ? highest : highest + 1)
+            : count_parameters(s, skip_token(s, i), highest);
+    }
+
+    constexpr bool keyword_at(const char* s, size_t i, const char* keyword)
+    {
+        return (*keyword == '\0') ? !is_ident(s[i])
+            : (to_lower(s[i]) == *keyword) && keyword_at(s, i + 1, keyword + 1);
+    }
+
+    // 'item_start' while nothing but whitespace followed SELECT or the last comma,
+    // a bare or qualified '*' makes the count unknown
+    constexpr int count_select_list(const char* s, size_t i, int depth, int columns, bool item_start, char previous)
+    {
+        return ((s[i] == '\0') || ((depth == 0) && (s[i] == ';'))) ? columns
+            : is_special(s, i) ? count_select_list(s, skip_token(s, i), depth, columns, false, 'x')
+            : is_space(s[i]) ? count_select_list(s, skip_space(s, i), depth, columns, item_start, previous)
+            : (s[i] == '(') ? count_select_list(s, i + 1, depth + 1, columns, false, '(')
+            : (s[i] == ')') ? count_select_list(s, i + 1, depth - 1, columns, false, ')')
+            : (depth != 0) ? count_select_list(s, skip_token(s, i), depth, columns, false, 'x')
+            : (s[i] == ',') ? count_select_list(s, i + 1, depth, columns + 1, true, ',')
+            : ((s[i] == '*') && (item_start || (previous == '.'))) ? -1
+            : keyword_at(s, i, "from") ? columns
+            : count_select_list(s, skip_token(s, i), depth, columns, false, s[i]);
+    }
+
+    // result columns of a plain SELECT, -1 when they can't be told from the text
+    constexpr int count_columns(const char* s)
+    {
+        return keyword_at(s, skip_space(s, 0), "select")
+            ? count_select_list(s, skip_space(s, 0) + 6, 0, 1, true, ' ')
+            : -1;
+    }
+
+    template <int I>
+    inline int bind_fixed(statement&)
+    {
+        return SQLITE_OK;
+    }
+
+    template <int I, typename Arg, typename... Args>
+    int bind_fixed(statement& stmt, Arg&& arg, Args&&... args)
+    {
+        const auto code = stmt.bind_at(I, std::forward<Arg>(arg));
+        return (code == SQLITE_OK)
+            ? bind_fixed<I + 1>(stmt, std::forward<Args>(args)...)
+            : code;
+    }
+}
+
+// query text with its parameter and result column counts worked out at compile time,
+// created through SQLITEPP_SQL so database::prepare can check the arguments
+// and read_columns/rows the values read back
+template <size_t Parameters, int Columns>
+struct sql_literal
+{
+    static constexpr size_t parameters = Parameters;
+    static constexpr int columns = Columns;
+
+    constexpr explicit sql_literal(const char* text)
+        : text(text)
+    {
+    }
+
+    // statement::read_columns and statement::rows with the column count checked,
+    // skipped when the count can't be told from the text
+    template <typename... Args>
+    int read_columns(const statement& stmt, Args&&... args) const
+    {
+        static_assert((Columns < 0) || (sizeof...(Args) == (size_t)Columns),
+            "The number of arguments doesn't match the columns of the query.");
+
+        return stmt.read_columns(std::forward<Args>(args)...);
+    }
+
+    template <typename... Ts>
+    row_range<Ts...> rows(statement& stmt) const
+    {
+        static_assert((Columns < 0) || (sizeof...(Ts) == (size_t)Columns),
+            "The number of row types doesn't match the columns of the query.");
+
+        return stmt.rows<Ts...>();
+    }
+
+    const char* text;
+};
+
+template <size_t Parameters, int Columns>
+constexpr size_t sql_literal<Parameters, Columns>::parameters;
+
+template <size_t Parameters, int Columns>
+constexpr int sql_literal<Parameters, Columns>::columns;
+
+} // sqlitepp
+
+#define SQLITEPP_SQL(text) \
+    ::sqlitepp::sql_literal< \
+        ::sqlitepp::detail::count_parameters(text), \
+        ::sqlitepp::detail::count_columns(text)>(text)
+
+#endif // SQLITEPP_SQL_H
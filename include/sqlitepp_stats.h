@@ -0,0 +1,94 @@
+#ifndef SQLITEPP_STATS_H
+#define SQLITEPP_STATS_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "sqlite3_inc.h"
+#include "sqlitepp_stmt.h"
+#include "sqlitepp_collector.h"
+
+namespace sqlitepp
+{
+
+struct query_stats
+{
+    std::string sql;
+    statement_counters totals;
+    // SQLITE_STMTSTATUS_MEMUSED is a size, not a counter
+    uint64_t max_memory_used = 0;
+
+    // signs of a missing index
+    bool has_full_scans() const
+    {
+        return totals.fullscan_steps != 0;
+    }
+
+    bool has_automatic_indexes() const
+    {
+        return totals.autoindexes != 0;
+    }
+};
+
+namespace detail
+{
+    struct stats_slot
+    {
+        explicit stats_slot(const char* text)
+        {
+            stats.sql = text;
+        }
+
+        const std::string& sql() const
+        {
+            return stats.sql;
+        }
+
+        query_stats stats;
+    };
+
+    // counters as of the previous run, they're never reset here so
+    // statement::get_counters() keeps working while stats are enabled
+    struct statement_stats
+    {
+        stats_slot* slot = nullptr;
+        statement_counters last;
+    };
+
+    // counters of one connection, the mutex is only contended while taking a snapshot
+    struct connection_stats
+        : connection_slots<stats_slot, statement_stats>
+    {
+        void record(sqlite3_stmt* stmt);
+    };
+}
+
+// sqlite3_stmt_status counters per SQL text, harvested after every run of
+// a statement on the databases it's enabled on, it has to outlive them
+class stats_registry
+{
+public:
+    stats_registry() noexcept = default;
+    stats_registry(const stats_registry&) = delete;
+    stats_registry& operator=(const stats_registry&) = delete;
+
+    // merged over all connections, by SQL text
+    std::vector<query_stats> snapshot() const;
+    // queries that did full table scans or built automatic indexes
+    std::vector<query_stats> flagged() const;
+
+private:
+    detail::connection_stats* attach()
+    {
+        return m_connections.attach();
+    }
+
+    detail::connection_list<detail::connection_stats> m_connections;
+
+    friend class database;
+};
+
+} // sqlitepp
+
+#endif // SQLITEPP_STATS_H
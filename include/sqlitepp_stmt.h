@@ -2,11 +2,22 @@
 #define SQLITEPP_STMT_H
 
 #include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <memory>
 #include <vector>
 #include <string>
 #include <cstring>
+#include <tuple>
+#include <type_traits>
 #include "sqlite3_inc.h"
 
+#ifdef SQLITEPP_INLINE_BINDINGS
+#define SQLITEPP_DETAIL_INLINE inline
+#else
+#define SQLITEPP_DETAIL_INLINE
+#endif // SQLITEPP_INLINE_BINDINGS
+
 namespace sqlitepp
 {
 
@@ -26,22 +37,155 @@ struct blob
     size_t length;
 };
 
+// borrowed column data, only valid until the statement steps, resets or is finalized
+struct text_view
+{
+    const char* ptr;
+    size_t length;
+};
+
+struct blob_view
+{
+    const void* ptr;
+    size_t length;
+};
+
+// sqlite3_stmt_status counters
+struct statement_counters
+{
+    uint64_t fullscan_steps = 0;
+    uint64_t sorts = 0;
+    uint64_t autoindexes = 0;
+    uint64_t vm_steps = 0;
+    uint64_t reprepares = 0;
+    uint64_t runs = 0;
+    uint64_t memory_used = 0;
+};
+
+// binds a blob of 'length' zero bytes, to be filled later through a blob_stream
+struct zeroblob
+{
+    uint64_t length;
+};
+
 namespace detail
 {
-    int bind(sqlite3_stmt* stmt, int index, int32_t value);
-    int bind(sqlite3_stmt* stmt, int index, int64_t value);
-    int bind(sqlite3_stmt* stmt, int index, double value);
-    int bind(sqlite3_stmt* stmt, int index, const char* value);
-    int bind(sqlite3_stmt* stmt, int index, const std::string& value);
-    int bind(sqlite3_stmt* stmt, int index, const std::vector<char>& value);
-    int bind(sqlite3_stmt* stmt, int index, const void* src_ptr, size_t length);
-
-    int read(sqlite3_stmt* stmt, int index, int32_t& value);
-    int read(sqlite3_stmt* stmt, int index, int64_t& value);
-    int read(sqlite3_stmt* stmt, int index, double& value);
-    int read(sqlite3_stmt* stmt, int index, std::string& value);
-    int read(sqlite3_stmt* stmt, int index, std::vector<char>& value);
-    int read(sqlite3_stmt* stmt, int index, void* dst_ptr, size_t length);
+    // FNV-1a, usable on string literals at compile time
+    constexpr uint64_t fnv1a(const char* text, uint64_t hash = 14695981039346656037ULL)
+    {
+        return (*text == '\0')
+            ? hash
+            : fnv1a(text + 1, (hash ^ static_cast<unsigned char>(*text)) * 1099511628211ULL);
+    }
+
+    struct named_parameter
+    {
+        uint64_t hash;
+        std::string name;
+        int index;
+    };
+
+    // buffers moved into a statement, kept until rebound, cleared or finalized;
+    // heap allocated so moving the statement doesn't move the bound data
+    struct owned_value
+    {
+        std::string text;
+        std::vector<char> blob;
+    };
+
+    // rvalue strings and buffers are bound without copying, everything else by reference
+    template <typename Arg>
+    struct is_owned_arg
+        : std::integral_constant<
+        bool,
+        !std::is_lvalue_reference<Arg>::value &&
+        (std::is_same<typename std::remove_cv<Arg>::type, std::string>::value ||
+         std::is_same<typename std::remove_cv<Arg>::type, std::vector<char>>::value ||
+         std::is_same<typename std::remove_cv<Arg>::type, std::unique_ptr<char[]>>::value ||
+         std::is_same<typename std::remove_cv<Arg>::type, std::vector<int64_t>>::value ||
+         std::is_same<typename std::remove_cv<Arg>::type, std::vector<std::string>>::value)>
+    {
+    };
+}
+
+// parameter name with its hash, see SQLITEPP_PARAM for hashing at compile time
+struct parameter_name
+{
+    constexpr parameter_name(const char* text, uint64_t hash)
+        : text(text),
+        hash(hash)
+    {
+    }
+
+    explicit parameter_name(const char* text)
+        : text(text),
+        hash(detail::fnv1a(text))
+    {
+    }
+
+    const char* text;
+    uint64_t hash;
+};
+
+#define SQLITEPP_PARAM(name) \
+    ::sqlitepp::parameter_name(name, \
+        std::integral_constant<uint64_t, ::sqlitepp::detail::fnv1a(name)>::value)
+
+// one result column in struct-of-arrays layout, filled by statement::fetch_columns;
+// NULL cells hold a default constructed value and have their bit set in 'nulls'
+template <typename T>
+struct column_batch
+{
+    std::vector<T> values;
+    std::vector<uint64_t> nulls;
+
+    size_t size() const
+    {
+        return values.size();
+    }
+
+    bool is_null(size_t row) const
+    {
+        return (nulls[row / 64] >> (row % 64)) & 1;
+    }
+
+    void clear()
+    {
+        values.clear();
+        nulls.clear();
+    }
+};
+
+namespace detail
+{
+    SQLITEPP_DETAIL_INLINE void delete_char_array(void* ptr);
+
+    SQLITEPP_DETAIL_INLINE int bind(sqlite3_stmt* stmt, int index, int32_t value);
+    SQLITEPP_DETAIL_INLINE int bind(sqlite3_stmt* stmt, int index, int64_t value);
+    SQLITEPP_DETAIL_INLINE int bind(sqlite3_stmt* stmt, int index, double value);
+    SQLITEPP_DETAIL_INLINE int bind(sqlite3_stmt* stmt, int index, const char* value);
+    SQLITEPP_DETAIL_INLINE int bind(sqlite3_stmt* stmt, int index, const std::string& value);
+    SQLITEPP_DETAIL_INLINE int bind(sqlite3_stmt* stmt, int index, const std::vector<char>& value);
+    SQLITEPP_DETAIL_INLINE int bind(sqlite3_stmt* stmt, int index, const text_view& value);
+    SQLITEPP_DETAIL_INLINE int bind(sqlite3_stmt* stmt, int index, const blob_view& value);
+    SQLITEPP_DETAIL_INLINE int bind(sqlite3_stmt* stmt, int index, const zeroblob& value);
+    SQLITEPP_DETAIL_INLINE int bind(sqlite3_stmt* stmt, int index, const void* src_ptr, size_t length);
+
+    // array parameters for the table-valued function from database::create_array_module,
+    // rvalues are moved into the binding, lvalues have to outlive the step
+    int bind(sqlite3_stmt* stmt, int index, const std::vector<int64_t>& values);
+    int bind(sqlite3_stmt* stmt, int index, const std::vector<std::string>& values);
+    int bind(sqlite3_stmt* stmt, int index, std::vector<int64_t>&& values);
+    int bind(sqlite3_stmt* stmt, int index, std::vector<std::string>&& values);
+
+    SQLITEPP_DETAIL_INLINE int read(sqlite3_stmt* stmt, int index, int32_t& value);
+    SQLITEPP_DETAIL_INLINE int read(sqlite3_stmt* stmt, int index, int64_t& value);
+    SQLITEPP_DETAIL_INLINE int read(sqlite3_stmt* stmt, int index, double& value);
+    SQLITEPP_DETAIL_INLINE int read(sqlite3_stmt* stmt, int index, std::string& value);
+    SQLITEPP_DETAIL_INLINE int read(sqlite3_stmt* stmt, int index, std::vector<char>& value);
+    SQLITEPP_DETAIL_INLINE int read(sqlite3_stmt* stmt, int index, text_view& value);
+    SQLITEPP_DETAIL_INLINE int read(sqlite3_stmt* stmt, int index, blob_view& value);
+    SQLITEPP_DETAIL_INLINE int read(sqlite3_stmt* stmt, int index, void* dst_ptr, size_t length);
 
     template<class T>
     struct is_c_str
@@ -62,16 +206,27 @@ namespace detail
     {
     };
 
+    template<class T>
+    struct is_special_arg
+        : std::integral_constant<
+        bool,
+        std::is_same<T, std::nullptr_t>::value ||
+        std::is_same<T, skip_arg>::value ||
+        std::is_same<T, const_blob>::value ||
+        std::is_same<T, blob>::value>
+    {
+    };
+
     template <typename Arg>
     typename std::enable_if<std::is_same<Arg, std::nullptr_t>::value, int>::type
-        bind_if(sqlite3_stmt* stmt, int index, const Arg& arg)
+        bind_if(sqlite3_stmt* stmt, int index, const Arg&)
     {
         return sqlite3_bind_null(stmt, index);
     }
 
     template <typename Arg>
     typename std::enable_if<std::is_same<Arg, const_blob>::value ||
-                            std::is_same<Arg, blob>::value>::type
+                            std::is_same<Arg, blob>::value, int>::type
         bind_if(sqlite3_stmt* stmt, int index, const Arg& arg)
     {
         return bind(stmt, index, arg.ptr, arg.length);
@@ -79,27 +234,27 @@ namespace detail
 
     template <typename Arg>
     typename std::enable_if<std::is_same<Arg, skip_arg>::value, int>::type
-        bind_if(sqlite3_stmt* stmt, int index, const Arg& arg)
+        bind_if(sqlite3_stmt*, int, const Arg&)
     {
         return SQLITE_OK; // skip this
     }
 
     template <typename Arg>
-    typename std::enable_if<!std::is_same<Arg, skip_arg>::value, int>::type
+    typename std::enable_if<!is_special_arg<Arg>::value, int>::type
         bind_if(sqlite3_stmt* stmt, int index, const Arg& arg)
     {
         return bind(stmt, index, arg);
     }
 
     template <typename Arg>
-    typename std::enable_if<std::is_same<Arg, std::nullptr_t>::value, int>::type
-        read_if(sqlite3_stmt* stmt, int index, Arg& arg)
+    typename std::enable_if<std::is_same<typename std::decay<Arg>::type, std::nullptr_t>::value, int>::type
+        read_if(sqlite3_stmt*, int, Arg&)
     {
         return SQLITE_OK; // do not read into nullptr
     }
 
     template <typename Arg>
-    typename std::enable_if<std::is_same<Arg, blob>::value>::type
+    typename std::enable_if<std::is_same<typename std::decay<Arg>::type, blob>::value, int>::type
         read_if(sqlite3_stmt* stmt, int index, Arg& arg)
     {
         return read(stmt, index, arg.ptr, arg.length);
@@ -107,19 +262,149 @@ namespace detail
 
     template <typename Arg>
     typename std::enable_if<std::is_same<typename std::decay<Arg>::type, skip_arg>::value, int>::type
-        read_if(sqlite3_stmt* stmt, int index, Arg& arg)
+        read_if(sqlite3_stmt*, int, Arg&)
     {
         return SQLITE_OK; // skip this
     }
 
     template <typename Arg>
-    typename std::enable_if<!std::is_same<typename std::decay<Arg>::type, skip_arg>::value, int>::type
+    typename std::enable_if<!is_special_arg<typename std::decay<Arg>::type>::value, int>::type
         read_if(sqlite3_stmt* stmt, int index, Arg& arg)
     {
         return read(stmt, index, arg);
     }
+
+    // binds tuple elements [I, N) to consecutive parameters after 'offset'
+    template <size_t I, size_t N>
+    struct tuple_binder
+    {
+        template <typename Tuple>
+        static int apply(sqlite3_stmt* stmt, int offset, const Tuple& values)
+        {
+            typedef typename std::tuple_element<I, Tuple>::type element_type;
+
+            const auto code = bind_if<element_type>(stmt, offset + (int)I + 1, std::get<I>(values));
+            return (code == SQLITE_OK)
+                ? tuple_binder<I + 1, N>::apply(stmt, offset, values)
+                : code;
+        }
+    };
+
+    template <size_t N>
+    struct tuple_binder<N, N>
+    {
+        template <typename Tuple>
+        static int apply(sqlite3_stmt*, int, const Tuple&)
+        {
+            return SQLITE_OK;
+        }
+    };
+
+    // reads columns [I, N) into the matching tuple elements
+    template <size_t I, size_t N>
+    struct tuple_reader
+    {
+        template <typename Tuple>
+        static int apply(sqlite3_stmt* stmt, Tuple& values)
+        {
+            typedef typename std::tuple_element<I, Tuple>::type element_type;
+
+            const auto code = read_if<element_type>(stmt, (int)I, std::get<I>(values));
+            return (code == SQLITE_OK)
+                ? tuple_reader<I + 1, N>::apply(stmt, values)
+                : code;
+        }
+    };
+
+    template <size_t N>
+    struct tuple_reader<N, N>
+    {
+        template <typename Tuple>
+        static int apply(sqlite3_stmt*, Tuple&)
+        {
+            return SQLITE_OK;
+        }
+    };
+
+    struct tuple_row_binder;
+
+    template <typename... Ts>
+    struct has_view
+        : std::false_type
+    {
+    };
+
+    template <typename T, typename... Ts>
+    struct has_view<T, Ts...>
+        : std::integral_constant<
+        bool,
+        std::is_same<T, text_view>::value ||
+        std::is_same<T, blob_view>::value ||
+        has_view<Ts...>::value>
+    {
+    };
+
+    // drops the rows from 'rows' on, so a failed row leaves no partial values behind
+    template <typename T>
+    void truncate_column(column_batch<T>& column, size_t rows)
+    {
+        column.values.erase(column.values.begin() + rows, column.values.end());
+        column.nulls.resize((rows + 63) / 64);
+
+        if (rows % 64 != 0)
+        {
+            column.nulls.back() &= (uint64_t(1) << (rows % 64)) - 1;
+        }
+    }
+
+    template <typename T>
+    void reserve_column(column_batch<T>& column, size_t rows)
+    {
+        const size_t total = column.values.size() + rows;
+
+        column.values.reserve(total);
+        column.nulls.reserve((total + 63) / 64);
+    }
+
+    template <typename T>
+    int append_column(sqlite3_stmt* stmt, int index, column_batch<T>& column)
+    {
+        const size_t row = column.values.size();
+        if (row % 64 == 0)
+        {
+            column.nulls.push_back(0);
+        }
+
+        column.values.emplace_back();
+        if (sqlite3_column_type(stmt, index) == SQLITE_NULL)
+        {
+            column.nulls.back() |= uint64_t(1) << (row % 64);
+            return SQLITE_OK;
+        }
+
+        return read(stmt, index, column.values.back());
+    }
+
+    // appends columns [I, I + sizeof...(Ts)) of the current row
+    template <int I>
+    inline int append_columns(sqlite3_stmt*)
+    {
+        return SQLITE_OK;
+    }
+
+    template <int I, typename T, typename... Ts>
+    int append_columns(sqlite3_stmt* stmt, column_batch<T>& column, column_batch<Ts>&... columns)
+    {
+        const auto code = append_column(stmt, I, column);
+        return (code == SQLITE_OK)
+            ? append_columns<I + 1>(stmt, columns...)
+            : code;
+    }
 }
 
+template <typename... Ts>
+class row_range;
+
 class statement
 {
 public:
@@ -129,25 +414,63 @@ public:
     statement& operator=(const statement&) = delete;
     ~statement() noexcept;
 
+    // rvalue std::string, std::vector<char> and std::unique_ptr<char[]> arguments
+    // are moved into the statement (the std::unique_ptr<char[]> text NUL terminated),
+    // anything else has to outlive the step
     template <typename Arg, typename... Args>
-    int bind(const Arg& first, const Args&... args);
+    int bind(Arg&& first, Args&&... args);
     template <typename Arg>
-    int bind(const Arg& last);
+    int bind(Arg&& last);
 
     template <typename Arg>
-    int bind_at(int index, const Arg& arg);
+    int bind_at(int index, Arg&& arg);
 
     int bind_text(int index, const char* text);
     int bind_text(int index, const std::string& text);
-    int bind_blob(int index, const std::vector<char>& value);
+    int bind_text(int index, std::string&& text);
+    // SQLite takes over the buffer and frees it with delete[]
+    int bind_text(int index, std::unique_ptr<char[]> text, size_t length);
+    int bind_blob(int index, const std::vector<char>& blob);
+    int bind_blob(int index, std::vector<char>&& blob);
+    int bind_blob(int index, std::unique_ptr<char[]> blob, size_t length);
     int bind_blob(int index, const void* ptr, size_t length);
     template <typename Arg>
     int bind_blob(int index, const Arg& value);
 
+    template <typename Tuple>
+    int bind_tuple(const Tuple& values, int offset = 0);
+
+    // names are looked up in a table built on first use and kept for the statement's lifetime
     int get_argument_index(const char* name) const;
+    int get_argument_index(const parameter_name& name) const;
+
+    template <typename Arg>
+    int bind_named(const char* name, Arg&& arg);
+    template <typename Arg>
+    int bind_named(const parameter_name& name, Arg&& arg);
+
+    int reset();
+    // SQLITE_MISUSE while the statement is running, reset it first
+    int clear_bindings();
+    template <typename Arg, typename... Args>
+    int rebind(Arg&& first, Args&&... args);
 
     int execute();
 
+    template <typename Range>
+    int execute_many(const Range& rows);
+    template <typename Range, typename Binder>
+    int execute_many(const Range& rows, Binder binder);
+
+    template <typename... Ts>
+    row_range<Ts...> rows();
+
+    // steps up to 'batch_size' rows and appends every column to its own batch;
+    // SQLITE_ROW when the batch filled up, SQLITE_DONE when the rows ran out;
+    // a row that fails to decode isn't appended to any of the batches
+    template <typename... Ts>
+    int fetch_columns(size_t batch_size, column_batch<Ts>&... columns);
+
     template <typename... Args>
     bool read_row(Args&&... args);
     bool next_row();
@@ -162,14 +485,23 @@ public:
     int read_column_at(int index, Arg&& arg) const;
 
     int read_text(int index, std::string& text) const;
+    int read_text(int index, text_view& text) const;
     int read_blob(int index, std::vector<char>& value) const;
+    int read_blob(int index, blob_view& value) const;
     int read_blob(int index, void* ptr, size_t length) const;
     template <typename Arg>
     int read_blob(int index, Arg& value) const;
+    template <typename Tuple>
+    int read_tuple(Tuple& values) const;
 
     int get_column_count() const;
     const char* get_column_name(int index) const;
 
+    bool is_readonly() const;
+
+    int get_status(int op, bool reset = false) const;
+    statement_counters get_counters(bool reset = false) const;
+
     int finalize();
 
     bool ok() const
@@ -192,39 +524,107 @@ private:
     int m_exec_status = SQLITE_OK;
     bool m_exec_before_next_row = false;
 
+    mutable std::vector<detail::named_parameter> m_named_parameters;
+    mutable bool m_named_parameters_built = false;
+
+    void build_named_parameters() const;
+
+    std::vector<std::unique_ptr<detail::owned_value>> m_owned_values;
+
+    detail::owned_value* get_owned_value(int index);
+
+    template <typename Arg>
+    int bind_value(int index, Arg&& arg, std::true_type);
+    template <typename Arg>
+    int bind_value(int index, const Arg& arg, std::false_type);
+    int bind_owned(int index, std::string&& text);
+    int bind_owned(int index, std::vector<char>&& blob);
+    // the length is taken with strlen, so the buffer has to be NUL terminated;
+    // bind_text(index, text, length) takes buffers that aren't
+    int bind_owned(int index, std::unique_ptr<char[]>&& text);
+    int bind_owned(int index, std::vector<int64_t>&& values);
+    int bind_owned(int index, std::vector<std::string>&& values);
+
     friend class database;
+    friend class statement_cache;
+    friend class script;
+    template <typename... Ts>
+    friend class row_range;
 };
 
 template <typename Arg>
-int statement::bind(const Arg& last)
+int statement::bind(Arg&& last)
 {
     ++m_bind_index;
-    return bind_at(m_bind_index, last);
+    return bind_at(m_bind_index, std::forward<Arg>(last));
 }
 
 template <typename Arg, typename... Args>
-int statement::bind(const Arg& first, const Args&... args)
+int statement::bind(Arg&& first, Args&&... args)
 {
     // increase index counter
     ++m_bind_index;
     // bind current parameter
-    const auto code = bind_at(m_bind_index, first);
+    const auto code = bind_at(m_bind_index, std::forward<Arg>(first));
 
     // bind next parameters
     return (code == SQLITE_OK)
-        ? bind(args...)
+        ? bind(std::forward<Args>(args)...)
         : code;
 }
 
 template <typename Arg>
-int statement::bind_at(int index, const Arg& arg)
+int statement::bind_at(int index, Arg&& arg)
 {
-    static_assert(!detail::is_void<Arg>::value,
+    typedef typename std::remove_cv<typename std::remove_reference<Arg>::type>::type value_type;
+
+    static_assert(!detail::is_void<value_type>::value,
         "You can't bind void types. There's no information about their size. "
         "It is recommended to use std::vector<char> to bind blobs. You can, "
         "however, pass 'const_blob' or 'blob' to bind a void type.");
 
-    return detail::bind_if<Arg>(m_handle, m_bind_index, arg);
+    return bind_value(index, std::forward<Arg>(arg), detail::is_owned_arg<Arg>());
+}
+
+template <typename Arg>
+int statement::bind_value(int index, Arg&& arg, std::true_type)
+{
+    return bind_owned(index, std::move(arg));
+}
+
+template <typename Arg>
+int statement::bind_value(int index, const Arg& arg, std::false_type)
+{
+    return detail::bind_if<Arg>(m_handle, index, arg);
+}
+
+template <typename Arg>
+int statement::bind_named(const char* name, Arg&& arg)
+{
+    return bind_named(parameter_name(name), std::forward<Arg>(arg));
+}
+
+template <typename Arg>
+int statement::bind_named(const parameter_name& name, Arg&& arg)
+{
+    const int index = get_argument_index(name);
+    return (index != 0)
+        ? bind_at(index, std::forward<Arg>(arg))
+        : SQLITE_RANGE;
+}
+
+template <typename Arg, typename... Args>
+int statement::rebind(Arg&& first, Args&&... args)
+{
+    // the previous run's result doesn't matter when starting over
+    reset();
+    return bind(std::forward<Arg>(first), std::forward<Args>(args)...);
+}
+
+template <typename Tuple>
+int statement::bind_tuple(const Tuple& values, int offset)
+{
+    return detail::tuple_binder<0, std::tuple_size<Tuple>::value>::apply(m_handle, offset, values);
 }
 
 template <typename Arg>
@@ -291,7 +691,7 @@ int statement::read_column_at(int index, Arg&& arg) const
     static_assert(!detail::is_c_str<Arg>::value,
         "Text needs to be read into a std::string type.");
 
-    return detail::read_if<Arg>(m_handle, m_read_index, arg);
+    return detail::read_if<Arg>(m_handle, index, arg);
 }
 
 template <typename Arg>
@@ -300,6 +700,211 @@ int statement::read_blob(int index, Arg& value) const
     return detail::read(m_handle, index, reinterpret_cast<void*>(&value), sizeof(Arg));
 }
 
+template <typename Tuple>
+int statement::read_tuple(Tuple& values) const
+{
+    return detail::tuple_reader<0, std::tuple_size<Tuple>::value>::apply(m_handle, values);
+}
+
+// single pass over the remaining rows of a statement, each row is decoded
+// in place into the same tuple, so borrowed views only live until the next step
+template <typename... Ts>
+class row_range
+{
+public:
+    typedef std::tuple<Ts...> value_type;
+
+    class iterator
+    {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef typename row_range::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const value_type* pointer;
+        typedef const value_type& reference;
+
+        iterator() noexcept = default;
+
+        reference operator*() const
+        {
+            return m_range->m_row;
+        }
+
+        pointer operator->() const
+        {
+            return &m_range->m_row;
+        }
+
+        iterator& operator++()
+        {
+            if (!m_range->advance())
+            {
+                m_range = nullptr;
+            }
+
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const
+        {
+            return m_range == other.m_range;
+        }
+
+        bool operator!=(const iterator& other) const
+        {
+            return m_range != other.m_range;
+        }
+
+    private:
+        explicit iterator(row_range* range) noexcept
+            : m_range(range)
+        {
+        }
+
+        row_range* m_range = nullptr;
+
+        friend class row_range;
+    };
+
+    iterator begin()
+    {
+        if (!m_started)
+        {
+            m_started = true;
+            m_has_row = advance();
+        }
+
+        return iterator(m_has_row ? this : nullptr);
+    }
+
+    iterator end()
+    {
+        return iterator();
+    }
+
+    // SQLITE_OK when iteration stopped at SQLITE_DONE, otherwise the step or decode error
+    int status() const
+    {
+        return m_status;
+    }
+
+private:
+    explicit row_range(statement& stmt)
+        : m_stmt(&stmt)
+    {
+    }
+
+    bool advance()
+    {
+        m_status = m_stmt->execute();
+        if (m_status != SQLITE_OK)
+        {
+            return (m_has_row = false);
+        }
+
+        if (m_stmt->m_exec_status != SQLITE_ROW)
+        {
+            return (m_has_row = false);
+        }
+
+        m_status = m_stmt->read_tuple(m_row);
+        return (m_has_row = (m_status == SQLITE_OK));
+    }
+
+    statement* m_stmt;
+    value_type m_row;
+    int m_status = SQLITE_OK;
+    bool m_started = false;
+    bool m_has_row = false;
+
+    friend class statement;
+};
+
+template <typename... Ts>
+row_range<Ts...> statement::rows()
+{
+    return row_range<Ts...>(*this);
+}
+
+template <typename... Ts>
+int statement::fetch_columns(size_t batch_size, column_batch<Ts>&... columns)
+{
+    static_assert(sizeof...(Ts) > 0,
+        "Fetch should be called with at least one column batch.");
+
+    static_assert(!detail::has_view<Ts...>::value,
+        "Views point into the statement's current row, they can't outlive a batch.");
+
+    const int expand[] = { (detail::reserve_column(columns, batch_size), 0)... };
+    (void)expand;
+
+    for (size_t row = 0; row < batch_size; ++row)
+    {
+        if (!next_row())
+        {
+            return m_exec_status;
+        }
+
+        const size_t sizes[] = { columns.size()... };
+
+        const auto code = detail::append_columns<0>(m_handle, columns...);
+        if (code != SQLITE_OK)
+        {
+            size_t column = 0;
+            const int truncate[] = { (detail::truncate_column(columns, sizes[column++]), 0)... };
+            (void)truncate;
+
+            return code;
+        }
+    }
+
+    return SQLITE_ROW;
+}
+
+namespace detail
+{
+    struct tuple_row_binder
+    {
+        template <typename Row>
+        int operator()(statement& stmt, const Row& row) const
+        {
+            return stmt.bind_tuple(row);
+        }
+    };
+}
+
+template <typename Range>
+int statement::execute_many(const Range& rows)
+{
+    return execute_many(rows, detail::tuple_row_binder());
+}
+
+template <typename Range, typename Binder>
+int statement::execute_many(const Range& rows, Binder binder)
+{
+    for (const auto& row : rows)
+    {
+        reset();
+
+        auto code = binder(*this, row);
+        if (code == SQLITE_OK)
+        {
+            code = execute();
+        }
+
+        if (code != SQLITE_OK)
+        {
+            return code;
+        }
+    }
+
+    return SQLITE_OK;
+}
+
 } // sqlitepp
 
+#ifdef SQLITEPP_INLINE_BINDINGS
+#include "sqlitepp_stmt.inl"
+#endif // SQLITEPP_INLINE_BINDINGS
+
 #endif // SQLITEPP_STMT_H
@@ -0,0 +1,162 @@
+#ifndef SQLITEPP_STMT_INL
+#define SQLITEPP_STMT_INL
+
+// definitions of the detail::bind/read overloads, compiled into the library
+// or, with SQLITEPP_INLINE_BINDINGS, included by sqlitepp_stmt.h so the hot path can be inlined
+
+namespace sqlitepp
+{
+
+namespace detail
+{
+    SQLITEPP_DETAIL_INLINE void delete_char_array(void* ptr)
+    {
+        delete[] static_cast<char*>(ptr);
+    }
+
+    SQLITEPP_DETAIL_INLINE int bind(sqlite3_stmt* stmt, int index, int32_t value)
+    {
+        return sqlite3_bind_int(stmt, index, value);
+    }
+
+    SQLITEPP_DETAIL_INLINE int bind(sqlite3_stmt* stmt, int index, int64_t value)
+    {
+        return sqlite3_bind_int64(stmt, index, value);
+    }
+
+    SQLITEPP_DETAIL_INLINE int bind(sqlite3_stmt* stmt, int index, double value)
+    {
+        return sqlite3_bind_double(stmt, index, value);
+    }
+
+    SQLITEPP_DETAIL_INLINE int bind(sqlite3_stmt* stmt, int index, const char* value)
+    {
+        return sqlite3_bind_text64(stmt, index, value, (sqlite3_uint64)strlen(value), SQLITE_STATIC, SQLITE_UTF8);
+    }
+
+    SQLITEPP_DETAIL_INLINE int bind(sqlite3_stmt* stmt, int index, const std::string& value)
+    {
+        return sqlite3_bind_text64(stmt, index, value.data(), (sqlite3_uint64)value.length(), SQLITE_STATIC, SQLITE_UTF8);
+    }
+
+    SQLITEPP_DETAIL_INLINE int bind(sqlite3_stmt* stmt, int index, const std::vector<char>& value)
+    {
+        return sqlite3_bind_blob64(stmt, index, value.data(), (sqlite3_uint64)value.size(), SQLITE_STATIC);
+    }
+
+    SQLITEPP_DETAIL_INLINE int bind(sqlite3_stmt* stmt, int index, const text_view& value)
+    {
+        return sqlite3_bind_text64(stmt, index, value.ptr, (sqlite3_uint64)value.length, SQLITE_STATIC, SQLITE_UTF8);
+    }
+
+    SQLITEPP_DETAIL_INLINE int bind(sqlite3_stmt* stmt, int index, const blob_view& value)
+    {
+        return sqlite3_bind_blob64(stmt, index, value.ptr, (sqlite3_uint64)value.length, SQLITE_STATIC);
+    }
+
+    SQLITEPP_DETAIL_INLINE int bind(sqlite3_stmt* stmt, int index, const zeroblob& value)
+    {
+        return sqlite3_bind_zeroblob64(stmt, index, (sqlite3_uint64)value.length);
+    }
+
+    SQLITEPP_DETAIL_INLINE int bind(sqlite3_stmt* stmt, int index, const void* src_ptr, size_t length)
+    {
+        return sqlite3_bind_blob64(stmt, index, src_ptr, (sqlite3_uint64)length, SQLITE_STATIC);
+    }
+
+    SQLITEPP_DETAIL_INLINE int read(sqlite3_stmt* stmt, int index, int32_t& value)
+    {
+        if (sqlite3_column_type(stmt, index) != SQLITE_INTEGER)
+            return SQLITE_MISMATCH;
+
+        value = sqlite3_column_int(stmt, index);
+        return SQLITE_OK;
+    }
+
+    SQLITEPP_DETAIL_INLINE int read(sqlite3_stmt* stmt, int index, int64_t& value)
+    {
+        if (sqlite3_column_type(stmt, index) != SQLITE_INTEGER)
+            return SQLITE_MISMATCH;
+
+        value = sqlite3_column_int64(stmt, index);
+        return SQLITE_OK;
+    }
+
+    SQLITEPP_DETAIL_INLINE int read(sqlite3_stmt* stmt, int index, double& value)
+    {
+        if (sqlite3_column_type(stmt, index) != SQLITE_FLOAT)
+            return SQLITE_MISMATCH;
+
+        value = sqlite3_column_double(stmt, index);
+        return SQLITE_OK;
+    }
+
+    SQLITEPP_DETAIL_INLINE int read(sqlite3_stmt* stmt, int index, std::string& value)
+    {
+        if (sqlite3_column_type(stmt, index) != SQLITE_TEXT)
+            return SQLITE_MISMATCH;
+
+        // column_bytes has to come after column_text, so the length matches the UTF-8 text
+        const auto* ptr = reinterpret_cast<const char*>(sqlite3_column_text(stmt, index));
+        value.assign(ptr, (size_t)sqlite3_column_bytes(stmt, index));
+        return SQLITE_OK;
+    }
+
+    SQLITEPP_DETAIL_INLINE int read(sqlite3_stmt* stmt, int index, text_view& value)
+    {
+        if (sqlite3_column_type(stmt, index) != SQLITE_TEXT)
+            return SQLITE_MISMATCH;
+
+        value.ptr = reinterpret_cast<const char*>(sqlite3_column_text(stmt, index));
+        value.length = (size_t)sqlite3_column_bytes(stmt, index);
+        return SQLITE_OK;
+    }
+
+    SQLITEPP_DETAIL_INLINE int read(sqlite3_stmt* stmt, int index, blob_view& value)
+    {
+        if (sqlite3_column_type(stmt, index) != SQLITE_BLOB)
+            return SQLITE_MISMATCH;
+
+        value.ptr = sqlite3_column_blob(stmt, index);
+        value.length = (size_t)sqlite3_column_bytes(stmt, index);
+        return SQLITE_OK;
+    }
+
+    SQLITEPP_DETAIL_INLINE int read(sqlite3_stmt* stmt, int index, std::vector<char>& value)
+    {
+        if (sqlite3_column_type(stmt, index) != SQLITE_BLOB)
+            return SQLITE_MISMATCH;
+
+        const auto* ptr = sqlite3_column_blob(stmt, index);
+        if (ptr != nullptr)
+        {
+            const auto size = sqlite3_column_bytes(stmt, index);
+            value.resize(size);
+            memcpy(value.data(), ptr, size);
+        }
+
+        return SQLITE_OK;
+    }
+
+    SQLITEPP_DETAIL_INLINE int read(sqlite3_stmt* stmt, int index, void* dst_ptr, size_t length)
+    {
+        if (sqlite3_column_type(stmt, index) != SQLITE_BLOB)
+            return SQLITE_MISMATCH;
+
+        const auto size = sqlite3_column_bytes(stmt, index);
+        if ((size_t)size != length)
+            return SQLITE_MISUSE;
+
+        const auto* src_ptr = sqlite3_column_blob(stmt, index);
+        if (src_ptr != nullptr)
+        {
+            memcpy(dst_ptr, src_ptr, size);
+        }
+
+        return SQLITE_OK;
+    }
+}
+
+} // sqlitepp
+
+#endif // SQLITEPP_STMT_INL
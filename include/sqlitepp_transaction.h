@@ -0,0 +1,94 @@
+#ifndef SQLITEPP_TRANSACTION_H
+#define SQLITEPP_TRANSACTION_H
+
+#include <string>
+
+#include "sqlite3_inc.h"
+#include "sqlitepp_db.h"
+
+namespace sqlitepp
+{
+
+enum class transaction_mode
+{
+    deferred,
+    immediate,
+    exclusive
+};
+
+// rolls back on destruction unless committed
+class transaction
+{
+public:
+    explicit transaction(const database& db, transaction_mode mode = transaction_mode::deferred);
+    transaction(transaction&&) noexcept;
+    transaction(const transaction&) = delete;
+    transaction& operator=(transaction&&) noexcept;
+    transaction& operator=(const transaction&) = delete;
+    ~transaction();
+
+    int commit();
+    int rollback();
+
+    bool ok() const
+    {
+        return m_status == SQLITE_OK;
+    }
+
+    bool is_active() const
+    {
+        return m_active;
+    }
+
+    int status() const
+    {
+        return m_status;
+    }
+
+private:
+    const database* m_db = nullptr;
+    bool m_active = false;
+    int m_status = SQLITE_OK;
+};
+
+// nested transaction, rolled back to (and released) on destruction unless released
+class savepoint
+{
+public:
+    savepoint(const database& db, const char* name);
+    savepoint(savepoint&&) noexcept;
+    savepoint(const savepoint&) = delete;
+    savepoint& operator=(savepoint&&) noexcept;
+    savepoint& operator=(const savepoint&) = delete;
+    ~savepoint();
+
+    int release();
+    int rollback();
+
+    bool ok() const
+    {
+        return m_status == SQLITE_OK;
+    }
+
+    bool is_active() const
+    {
+        return m_active;
+    }
+
+    int status() const
+    {
+        return m_status;
+    }
+
+private:
+    int execute(const char* command) const;
+
+    const database* m_db = nullptr;
+    std::string m_name;
+    bool m_active = false;
+    int m_status = SQLITE_OK;
+};
+
+} // sqlitepp
+
+#endif // SQLITEPP_TRANSACTION_H
@@ -0,0 +1,325 @@
+#ifndef SQLITEPP_VTAB_H
+#define SQLITEPP_VTAB_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+#include "sqlite3_inc.h"
+#include "sqlitepp_function.h"
+
+namespace sqlitepp
+{
+
+namespace detail
+{
+    // idxNum flags chosen by best_key_index()
+    enum key_index_flags
+    {
+        key_eq = 1,
+        key_lower = 2,
+        key_lower_exclusive = 4,
+        key_upper = 8,
+        key_upper_exclusive = 16
+    };
+
+    // [first, last) of a key sorted ascending, taken from xFilter arguments
+    struct key_bounds
+    {
+        bool has_lower = false;
+        bool lower_exclusive = false;
+        int64_t lower = 0;
+
+        bool has_upper = false;
+        bool upper_exclusive = false;
+        int64_t upper = 0;
+    };
+
+    int best_key_index(sqlite3_index_info* info, int key_column, size_t rows);
+    key_bounds make_key_bounds(int flags, int argc, sqlite3_value** argv);
+
+    template <typename M>
+    typename std::enable_if<std::is_integral<M>::value, int64_t>::type
+        column_value(const M& value)
+    {
+        return static_cast<int64_t>(value);
+    }
+
+    template <typename M>
+    typename std::enable_if<std::is_floating_point<M>::value, double>::type
+        column_value(const M& value)
+    {
+        return static_cast<double>(value);
+    }
+
+    template <typename M>
+    typename std::enable_if<!std::is_arithmetic<M>::value, const M&>::type
+        column_value(const M& value)
+    {
+        return value;
+    }
+
+    template <typename M>
+    const char* column_type()
+    {
+        return std::is_integral<M>::value ? "INTEGER"
+            : std::is_floating_point<M>::value ? "REAL"
+            : std::is_same<M, std::vector<char>>::value ? "BLOB"
+            : "TEXT";
+    }
+
+    template <typename T>
+    struct vector_vtab;
+}
+
+// read-only view of a vector of structs as an eponymous virtual table;
+// the vector is not copied and has to outlive the connection
+template <typename T>
+class vector_table
+{
+public:
+    typedef std::function<void(sqlite3_context*, const T&)> column_reader;
+
+    explicit vector_table(const std::vector<T>& rows)
+        : m_rows(&rows)
+    {
+    }
+
+    template <typename M>
+    vector_table& column(const char* name, M T::* member)
+    {
+        m_columns.push_back(column_info{ name, detail::column_type<M>(),
+            [member](sqlite3_context* context, const T& row)
+            {
+                detail::set_result(context, detail::column_value(row.*member));
+            } });
+
+        return *this;
+    }
+
+    // rows have to be sorted ascending by this column, so equality and range
+    // constraints on it are answered with a binary search instead of a scan
+    template <typename M>
+    vector_table& key(const char* name, M T::* member)
+    {
+        static_assert(std::is_integral<M>::value, "key column has to be an integer");
+
+        m_key_column = (int)m_columns.size();
+        m_key = [member](const T& row)
+        {
+            return static_cast<int64_t>(row.*member);
+        };
+
+        return column(name, member);
+    }
+
+    std::string get_schema() const
+    {
+        std::string schema = "CREATE TABLE x(";
+        for (size_t i = 0; i < m_columns.size(); ++i)
+        {
+            if (i != 0)
+                schema += ", ";
+
+            schema += '"';
+            schema += m_columns[i].name;
+            schema += "\" ";
+            schema += m_columns[i].type;
+        }
+
+        schema += ')';
+        return schema;
+    }
+
+private:
+    struct column_info
+    {
+        std::string name;
+        const char* type;
+        column_reader read;
+    };
+
+    const std::vector<T>* m_rows;
+    std::vector<column_info> m_columns;
+
+    int m_key_column = -1;
+    std::function<int64_t(const T&)> m_key;
+
+    friend struct detail::vector_vtab<T>;
+};
+
+namespace detail
+{
+    template <typename T>
+    struct vector_vtab
+    {
+        struct table
+        {
+            sqlite3_vtab base;
+            const vector_table<T>* source;
+        };
+
+        struct cursor
+        {
+            sqlite3_vtab_cursor base;
+            size_t position;
+            size_t end;
+        };
+
+        static const vector_table<T>& source_of(sqlite3_vtab_cursor* cur)
+        {
+            return *reinterpret_cast<table*>(cur->pVtab)->source;
+        }
+
+        static int connect(sqlite3* db, void* aux, int, const char* const*, sqlite3_vtab** vtab, char**)
+        {
+            const auto* source = static_cast<const vector_table<T>*>(aux);
+
+            const int code = sqlite3_declare_vtab(db, source->get_schema().c_str());
+            if (code != SQLITE_OK)
+                return code;
+
+            auto* result = static_cast<table*>(sqlite3_malloc(sizeof(table)));
+            if (result == nullptr)
+                return SQLITE_NOMEM;
+
+            memset(result, 0, sizeof(table));
+            result->source = source;
+
+            *vtab = &result->base;
+            return SQLITE_OK;
+        }
+
+        static int disconnect(sqlite3_vtab* vtab)
+        {
+            sqlite3_free(vtab);
+            return SQLITE_OK;
+        }
+
+        static int best_index(sqlite3_vtab* vtab, sqlite3_index_info* info)
+        {
+            const auto* source = reinterpret_cast<table*>(vtab)->source;
+            return best_key_index(info, source->m_key_column, source->m_rows->size());
+        }
+
+        static int open(sqlite3_vtab*, sqlite3_vtab_cursor** cur)
+        {
+            auto* result = static_cast<cursor*>(sqlite3_malloc(sizeof(cursor)));
+            if (result == nullptr)
+                return SQLITE_NOMEM;
+
+            memset(result, 0, sizeof(cursor));
+
+            *cur = &result->base;
+            return SQLITE_OK;
+        }
+
+        static int close(sqlite3_vtab_cursor* cur)
+        {
+            sqlite3_free(cur);
+            return SQLITE_OK;
+        }
+
+        static int filter(sqlite3_vtab_cursor* cur, int flags, const char*, int argc, sqlite3_value** argv)
+        {
+            auto* c = reinterpret_cast<cursor*>(cur);
+            const auto& source = source_of(cur);
+            const auto& rows = *source.m_rows;
+
+            c->position = 0;
+            c->end = rows.size();
+
+            if (flags == 0)
+                return SQLITE_OK;
+
+            const auto bounds = make_key_bounds(flags, argc, argv);
+            const auto& key = source.m_key;
+
+            if (bounds.has_lower)
+            {
+                const auto it = bounds.lower_exclusive
+                    ? std::upper_bound(rows.begin(), rows.end(), bounds.lower,
+                        [&key](int64_t value, const T& row) { return value < key(row); })
+                    : std::lower_bound(rows.begin(), rows.end(), bounds.lower,
+                        [&key](const T& row, int64_t value) { return key(row) < value; });
+
+                c->position = (size_t)(it - rows.begin());
+            }
+
+            if (bounds.has_upper)
+            {
+                const auto it = bounds.upper_exclusive
+                    ? std::lower_bound(rows.begin(), rows.end(), bounds.upper,
+                        [&key](const T& row, int64_t value) { return key(row) < value; })
+                    : std::upper_bound(rows.begin(), rows.end(), bounds.upper,
+                        [&key](int64_t value, const T& row) { return value < key(row); });
+
+                c->end = (size_t)(it - rows.begin());
+            }
+
+            return SQLITE_OK;
+        }
+
+        static int next(sqlite3_vtab_cursor* cur)
+        {
+            ++reinterpret_cast<cursor*>(cur)->position;
+            return SQLITE_OK;
+        }
+
+        static int eof(sqlite3_vtab_cursor* cur)
+        {
+            const auto* c = reinterpret_cast<cursor*>(cur);
+            return c->position >= c->end;
+        }
+
+        static int column(sqlite3_vtab_cursor* cur, sqlite3_context* context, int index)
+        {
+            const auto* c = reinterpret_cast<cursor*>(cur);
+            const auto& source = source_of(cur);
+
+            source.m_columns[index].read(context, (*source.m_rows)[c->position]);
+            return SQLITE_OK;
+        }
+
+        static int rowid(sqlite3_vtab_cursor* cur, sqlite3_int64* result)
+        {
+            *result = (sqlite3_int64)reinterpret_cast<cursor*>(cur)->position;
+            return SQLITE_OK;
+        }
+
+        // no xCreate, so the table only exists under the module name
+        static const sqlite3_module* get()
+        {
+            static const sqlite3_module module = make();
+            return &module;
+        }
+
+        static sqlite3_module make()
+        {
+            sqlite3_module module;
+            memset(&module, 0, sizeof(module));
+
+            module.xConnect = &connect;
+            module.xBestIndex = &best_index;
+            module.xDisconnect = &disconnect;
+            module.xOpen = &open;
+            module.xClose = &close;
+            module.xFilter = &filter;
+            module.xNext = &next;
+            module.xEof = &eof;
+            module.xColumn = &column;
+            module.xRowid = &rowid;
+
+            return module;
+        }
+    };
+}
+
+} // sqlitepp
+
+#endif // SQLITEPP_VTAB_H
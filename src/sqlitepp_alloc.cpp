@@ -0,0 +1,356 @@
+#include "sqlitepp_alloc.h"
+
+#include <cstdio>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif // __linux__
+
+namespace sqlitepp
+{
+
+namespace
+{
+    // every block starts with its size, keeping the user pointer 16 byte aligned
+    const size_t header_size = 16;
+    const size_t uncached_class = thread_caching_allocator::class_count;
+
+    struct block_header
+    {
+        size_t size;
+        size_t size_class;
+    };
+
+    struct free_block
+    {
+        free_block* next;
+    };
+
+    size_t size_class_of(size_t size)
+    {
+        size_t index = 0;
+        size_t class_size = thread_caching_allocator::min_class_size;
+        while (class_size < size)
+        {
+            class_size <<= 1;
+            ++index;
+        }
+
+        return index;
+    }
+
+    size_t class_size_of(size_t size_class)
+    {
+        return thread_caching_allocator::min_class_size << size_class;
+    }
+
+    block_header* header_of(void* ptr)
+    {
+        return reinterpret_cast<block_header*>(static_cast<char*>(ptr) - header_size);
+    }
+
+    struct thread_cache
+    {
+        ~thread_cache()
+        {
+            for (auto*& head : heads)
+            {
+                while (head != nullptr)
+                {
+                    auto* next = head->next;
+                    free(head);
+                    head = next;
+                }
+            }
+
+            // blocks freed later during thread teardown go straight back to malloc
+            destroyed = true;
+        }
+
+        free_block* heads[thread_caching_allocator::class_count] = {};
+        size_t counts[thread_caching_allocator::class_count] = {};
+        bool destroyed = false;
+    };
+
+    thread_local thread_cache cache;
+
+    int init(void*)
+    {
+        return SQLITE_OK;
+    }
+
+    void shutdown(void*)
+    {
+    }
+
+#if defined(__linux__) && defined(MAP_HUGETLB)
+    // MAP_HUGETLB lengths have to be multiples of it, or munmap fails
+    size_t huge_page_size()
+    {
+        static const size_t size = []() -> size_t
+        {
+            size_t kilobytes = 0;
+            if (FILE* meminfo = fopen("/proc/meminfo", "r"))
+            {
+                char line[128];
+                while (fgets(line, sizeof(line), meminfo) != nullptr)
+                {
+                    if (sscanf(line, "Hugepagesize: %zu kB", &kilobytes) == 1)
+                    {
+                        break;
+                    }
+                }
+
+                fclose(meminfo);
+            }
+
+            return (kilobytes != 0) ? kilobytes * 1024 : size_t(2) * 1024 * 1024;
+        }();
+
+        return size;
+    }
+#endif // __linux__ && MAP_HUGETLB
+}
+
+constexpr size_t thread_caching_allocator::min_class_size;
+constexpr size_t thread_caching_allocator::max_class_size;
+constexpr size_t thread_caching_allocator::class_count;
+constexpr size_t thread_caching_allocator::max_cached_blocks;
+
+const sqlite3_mem_methods& thread_caching_allocator::methods()
+{
+    static const sqlite3_mem_methods instance =
+    {
+        &thread_caching_allocator::allocate,
+        &thread_caching_allocator::release,
+        &thread_caching_allocator::reallocate,
+        &thread_caching_allocator::size_of,
+        &thread_caching_allocator::round_up,
+        &init,
+        &shutdown,
+        nullptr
+    };
+
+    return instance;
+}
+
+void* thread_caching_allocator::allocate(int size)
+{
+    if (size <= 0)
+    {
+        return nullptr;
+    }
+
+    const auto requested = (size_t)size;
+
+    size_t size_class = uncached_class;
+    size_t block_size = (requested + 7) & ~(size_t)7;
+
+    if (requested <= max_class_size)
+    {
+        size_class = size_class_of(requested);
+        block_size = class_size_of(size_class);
+
+        auto*& head = cache.heads[size_class];
+        if ((head != nullptr) && !cache.destroyed)
+        {
+            auto* block = head;
+            head = block->next;
+            --cache.counts[size_class];
+
+            // the link overwrote the size
+            auto* header = reinterpret_cast<block_header*>(block);
+            header->size = block_size;
+
+            return reinterpret_cast<char*>(header) + header_size;
+        }
+    }
+
+    auto* header = static_cast<block_header*>(malloc(header_size + block_size));
+    if (header == nullptr)
+    {
+        return nullptr;
+    }
+
+    header->size = block_size;
+    header->size_class = size_class;
+
+    return reinterpret_cast<char*>(header) + header_size;
+}
+
+void thread_caching_allocator::release(void* ptr)
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+
+    auto* header = header_of(ptr);
+    const auto size_class = header->size_class;
+
+    if ((size_class != uncached_class) &&
+        !cache.destroyed &&
+        (cache.counts[size_class] < max_cached_blocks))
+    {
+        // the header is kept, the link lives where the size used to be
+        auto* block = reinterpret_cast<free_block*>(header);
+        block->next = cache.heads[size_class];
+        cache.heads[size_class] = block;
+        ++cache.counts[size_class];
+
+        return;
+    }
+
+    free(header);
+}
+
+void* thread_caching_allocator::reallocate(void* ptr, int size)
+{
+    if (ptr == nullptr)
+    {
+        return allocate(size);
+    }
+
+    const auto current = header_of(ptr)->size;
+    if ((size > 0) && ((size_t)size <= current))
+    {
+        return ptr;
+    }
+
+    auto* result = allocate(size);
+    if (result != nullptr)
+    {
+        memcpy(result, ptr, current);
+        release(ptr);
+    }
+
+    return result;
+}
+
+int thread_caching_allocator::size_of(void* ptr)
+{
+    return (ptr != nullptr)
+        ? (int)header_of(ptr)->size
+        : 0;
+}
+
+int thread_caching_allocator::round_up(int size)
+{
+    if ((size > 0) && ((size_t)size <= max_class_size))
+    {
+        return (int)class_size_of(size_class_of((size_t)size));
+    }
+
+    return (size + 7) & ~7;
+}
+
+memory_region::memory_region(size_t size, bool huge_pages)
+    : m_size(size)
+{
+#if defined(__linux__)
+#if defined(MAP_HUGETLB)
+    if (huge_pages)
+    {
+        const size_t page = huge_page_size();
+        const size_t length = (size + page - 1) / page * page;
+
+        void* data = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (data != MAP_FAILED)
+        {
+            m_data = data;
+            m_size = length;
+            m_huge_pages = true;
+            m_mapped = true;
+            return;
+        }
+    }
+#endif // MAP_HUGETLB
+
+    // no reserved huge pages, transparent huge pages may still back the mapping
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data != MAP_FAILED)
+    {
+#if defined(MADV_HUGEPAGE)
+        if (huge_pages)
+        {
+            madvise(data, size, MADV_HUGEPAGE);
+        }
+#endif // MADV_HUGEPAGE
+
+        m_data = data;
+        m_mapped = true;
+        return;
+    }
+#else
+    (void)huge_pages;
+#endif // __linux__
+
+    m_data = malloc(size);
+    if (m_data == nullptr)
+    {
+        m_size = 0;
+    }
+}
+
+memory_region::memory_region(memory_region&& other) noexcept
+    : m_data(other.m_data),
+    m_size(other.m_size),
+    m_huge_pages(other.m_huge_pages),
+    m_mapped(other.m_mapped)
+{
+    other.m_data = nullptr;
+    other.m_size = 0;
+}
+
+memory_region& memory_region::operator=(memory_region&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_huge_pages = other.m_huge_pages;
+        m_mapped = other.m_mapped;
+
+        other.m_data = nullptr;
+        other.m_size = 0;
+    }
+
+    return *this;
+}
+
+memory_region::~memory_region()
+{
+    release();
+}
+
+void memory_region::release()
+{
+    if (m_data == nullptr)
+    {
+        return;
+    }
+
+#if defined(__linux__)
+    if (m_mapped)
+    {
+        const int code = munmap(m_data, m_size);
+        assert(code == 0);
+        (void)code;
+    }
+    else
+#endif // __linux__
+    {
+        free(m_data);
+    }
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+} // sqlitepp
@@ -0,0 +1,223 @@
+#include "sqlitepp_array.h"
+#include "sqlitepp_stmt.h"
+
+#include <cstring>
+
+namespace sqlitepp
+{
+
+namespace
+{
+    enum array_columns
+    {
+        column_value,
+        column_pointer
+    };
+
+    struct array_cursor
+    {
+        sqlite3_vtab_cursor base;
+        const detail::array_pointer* array;
+        size_t position;
+    };
+
+    int array_connect(sqlite3* db, void*, int, const char* const*, sqlite3_vtab** vtab, char**)
+    {
+        const int code = sqlite3_declare_vtab(db, "CREATE TABLE x(value, pointer HIDDEN)");
+        if (code != SQLITE_OK)
+            return code;
+
+        auto* result = static_cast<sqlite3_vtab*>(sqlite3_malloc(sizeof(sqlite3_vtab)));
+        if (result == nullptr)
+            return SQLITE_NOMEM;
+
+        memset(result, 0, sizeof(sqlite3_vtab));
+
+        *vtab = result;
+        return SQLITE_OK;
+    }
+
+    int array_disconnect(sqlite3_vtab* vtab)
+    {
+        sqlite3_free(vtab);
+        return SQLITE_OK;
+    }
+
+    int array_best_index(sqlite3_vtab*, sqlite3_index_info* info)
+    {
+        for (int i = 0; i < info->nConstraint; ++i)
+        {
+            const auto& constraint = info->aConstraint[i];
+            if (constraint.usable && (constraint.iColumn == column_pointer) &&
+                (constraint.op == SQLITE_INDEX_CONSTRAINT_EQ))
+            {
+                info->aConstraintUsage[i].argvIndex = 1;
+                info->aConstraintUsage[i].omit = 1;
+                info->idxNum = 1;
+                info->estimatedCost = 1;
+                info->estimatedRows = 100;
+
+                return SQLITE_OK;
+            }
+        }
+
+        // without the array argument there's nothing to scan, steer the planner away
+        info->idxNum = 0;
+        info->estimatedCost = 2147483647;
+        info->estimatedRows = 2147483647;
+
+        return SQLITE_OK;
+    }
+
+    int array_open(sqlite3_vtab*, sqlite3_vtab_cursor** cur)
+    {
+        auto* result = static_cast<array_cursor*>(sqlite3_malloc(sizeof(array_cursor)));
+        if (result == nullptr)
+            return SQLITE_NOMEM;
+
+        memset(result, 0, sizeof(array_cursor));
+
+        *cur = &result->base;
+        return SQLITE_OK;
+    }
+
+    int array_close(sqlite3_vtab_cursor* cur)
+    {
+        sqlite3_free(cur);
+        return SQLITE_OK;
+    }
+
+    int array_filter(sqlite3_vtab_cursor* cur, int flags, const char*, int argc, sqlite3_value** argv)
+    {
+        auto* c = reinterpret_cast<array_cursor*>(cur);
+
+        c->position = 0;
+        c->array = ((flags == 1) && (argc == 1))
+            ? static_cast<const detail::array_pointer*>(sqlite3_value_pointer(argv[0], detail::array_pointer_type))
+            : nullptr;
+
+        return SQLITE_OK;
+    }
+
+    int array_next(sqlite3_vtab_cursor* cur)
+    {
+        ++reinterpret_cast<array_cursor*>(cur)->position;
+        return SQLITE_OK;
+    }
+
+    int array_eof(sqlite3_vtab_cursor* cur)
+    {
+        const auto* c = reinterpret_cast<array_cursor*>(cur);
+        return (c->array == nullptr) || (c->position >= c->array->size);
+    }
+
+    int array_column(sqlite3_vtab_cursor* cur, sqlite3_context* context, int index)
+    {
+        const auto* c = reinterpret_cast<array_cursor*>(cur);
+        if (index != column_value)
+        {
+            sqlite3_result_null(context);
+        }
+        else if (c->array->integers != nullptr)
+        {
+            sqlite3_result_int64(context, c->array->integers[c->position]);
+        }
+        else
+        {
+            const auto& text = c->array->texts[c->position];
+
+            // the array outlives the step, so the text doesn't need a copy
+            sqlite3_result_text64(context, text.data(), (sqlite3_uint64)text.length(), SQLITE_STATIC, SQLITE_UTF8);
+        }
+
+        return SQLITE_OK;
+    }
+
+    int array_rowid(sqlite3_vtab_cursor* cur, sqlite3_int64* result)
+    {
+        *result = (sqlite3_int64)reinterpret_cast<array_cursor*>(cur)->position + 1;
+        return SQLITE_OK;
+    }
+
+    sqlite3_module make_array_module()
+    {
+        sqlite3_module module;
+        memset(&module, 0, sizeof(module));
+
+        // no xCreate, the module is only usable as a table-valued function
+        module.xConnect = &array_connect;
+        module.xBestIndex = &array_best_index;
+        module.xDisconnect = &array_disconnect;
+        module.xOpen = &array_open;
+        module.xClose = &array_close;
+        module.xFilter = &array_filter;
+        module.xNext = &array_next;
+        module.xEof = &array_eof;
+        module.xColumn = &array_column;
+        module.xRowid = &array_rowid;
+
+        return module;
+    }
+
+    void delete_array_pointer(void* ptr)
+    {
+        delete static_cast<detail::array_pointer*>(ptr);
+    }
+
+    int bind_array(sqlite3_stmt* stmt, int index, detail::array_pointer* array)
+    {
+        // SQLite calls the destructor even when the bind fails
+        return sqlite3_bind_pointer(stmt, index, array, detail::array_pointer_type, &delete_array_pointer);
+    }
+}
+
+namespace detail
+{
+    const char* const array_pointer_type = "sqlitepp_array";
+
+    const sqlite3_module* get_array_module()
+    {
+        static const sqlite3_module module = make_array_module();
+        return &module;
+    }
+
+    int bind(sqlite3_stmt* stmt, int index, const std::vector<int64_t>& values)
+    {
+        auto* array = new array_pointer();
+        array->integers = values.data();
+        array->size = values.size();
+
+        return bind_array(stmt, index, array);
+    }
+
+    int bind(sqlite3_stmt* stmt, int index, const std::vector<std::string>& values)
+    {
+        auto* array = new array_pointer();
+        array->texts = values.data();
+        array->size = values.size();
+
+        return bind_array(stmt, index, array);
+    }
+
+    int bind(sqlite3_stmt* stmt, int index, std::vector<int64_t>&& values)
+    {
+        auto* array = new array_pointer();
+        array->owned_integers = std::move(values);
+        array->integers = array->owned_integers.data();
+        array->size = array->owned_integers.size();
+
+        return bind_array(stmt, index, array);
+    }
+
+    int bind(sqlite3_stmt* stmt, int index, std::vector<std::string>&& values)
+    {
+        auto* array = new array_pointer();
+        array->owned_texts = std::move(values);
+        array->texts = array->owned_texts.data();
+        array->size = array->owned_texts.size();
+
+        return bind_array(stmt, index, array);
+    }
+}
+
+} // sqlitepp
@@ -0,0 +1,170 @@
+#include "sqlitepp_async.h"
+
+namespace sqlitepp
+{
+
+constexpr int async_database::default_busy_timeout;
+
+async_database::async_database(const char* db, size_t workers, int& result, int busy_timeout)
+{
+    result = open(db, workers, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, busy_timeout);
+}
+
+async_database::~async_database()
+{
+    close();
+}
+
+int async_database::open(const char* db, size_t workers, int flags, int busy_timeout)
+{
+    if (workers == 0)
+    {
+        return SQLITE_MISUSE;
+    }
+
+    // each connection only ever runs on its worker thread
+    flags |= SQLITE_OPEN_NOMUTEX;
+
+    std::vector<std::unique_ptr<worker>> opened;
+    for (size_t i = 0; i < workers; ++i)
+    {
+        std::unique_ptr<worker> w(new worker());
+
+        auto code = w->db.open(db, flags);
+        if ((code == SQLITE_OK) && (i == 0) && ((flags & SQLITE_OPEN_READWRITE) != 0))
+        {
+            // lets readers on the other workers run alongside a writer
+            code = w->db.execute("PRAGMA journal_mode=WAL");
+        }
+
+        if (code == SQLITE_OK)
+        {
+            code = w->db.set_busy_timeout(busy_timeout);
+        }
+
+        if (code != SQLITE_OK)
+        {
+            return code;
+        }
+
+        opened.push_back(std::move(w));
+    }
+
+    close();
+    m_workers = std::move(opened);
+
+    for (auto& w : m_workers)
+    {
+        auto* target = w.get();
+        target->thread = std::thread([target]() { run(*target); });
+    }
+
+    return SQLITE_OK;
+}
+
+void async_database::close()
+{
+    for (auto& w : m_workers)
+    {
+        {
+            std::lock_guard<std::mutex> lock(w->mutex);
+            w->stopping = true;
+        }
+
+        w->job_available.notify_one();
+    }
+
+    for (auto& w : m_workers)
+    {
+        if (w->thread.joinable())
+        {
+            w->thread.join();
+        }
+    }
+
+    m_workers.clear();
+}
+
+int async_database::post(job_type job)
+{
+    return post_to(pick_worker(), std::move(job));
+}
+
+int async_database::post_to(size_t worker, job_type job)
+{
+    if (worker >= m_workers.size())
+    {
+        return SQLITE_MISUSE;
+    }
+
+    auto& w = *m_workers[worker];
+    {
+        std::lock_guard<std::mutex> lock(w.mutex);
+        w.jobs.push_back(std::move(job));
+
+        // counted before the worker can pick it up and take it off again
+        w.pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    w.job_available.notify_one();
+
+    return SQLITE_OK;
+}
+
+void async_database::run(worker& w)
+{
+    for (;;)
+    {
+        job_type job;
+        {
+            std::unique_lock<std::mutex> lock(w.mutex);
+            w.job_available.wait(lock, [&w]() { return w.stopping || !w.jobs.empty(); });
+
+            // drain the queue before stopping
+            if (w.jobs.empty())
+            {
+                return;
+            }
+
+            job = std::move(w.jobs.front());
+            w.jobs.pop_front();
+        }
+
+        // an escaping exception would terminate the worker thread
+        try
+        {
+            job(w.db);
+        }
+        catch (...)
+        {
+        }
+
+        w.pending.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+size_t async_database::pick_worker() const
+{
+    // out of range, post_to reports it
+    if (m_workers.empty())
+    {
+        return 0;
+    }
+
+    size_t best = 0;
+    size_t best_pending = m_workers[0]->pending.load(std::memory_order_relaxed);
+
+    for (size_t i = 1; (i < m_workers.size()) && (best_pending != 0); ++i)
+    {
+        const auto pending = m_workers[i]->pending.load(std::memory_order_relaxed);
+        if (pending < best_pending)
+        {
+            best = i;
+            best_pending = pending;
+        }
+    }
+
+    return best;
+}
+
+} // sqlitepp
@@ -0,0 +1,74 @@
+#include "sqlitepp_blob.h"
+
+#include <climits>
+
+namespace sqlitepp
+{
+
+blob_stream::blob_stream(blob_stream&& other) noexcept
+    : m_handle(other.m_handle)
+{
+    other.m_handle = nullptr;
+}
+
+blob_stream& blob_stream::operator=(blob_stream&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+
+        m_handle = other.m_handle;
+        other.m_handle = nullptr;
+    }
+
+    return *this;
+}
+
+blob_stream::~blob_stream()
+{
+    close();
+}
+
+int blob_stream::read(void* buffer, size_t length, size_t offset) const
+{
+    // the incremental blob API takes int sizes
+    if ((length > INT_MAX) || (offset > INT_MAX))
+        return SQLITE_TOOBIG;
+
+    return sqlite3_blob_read(m_handle, buffer, (int)length, (int)offset);
+}
+
+int blob_stream::write(const void* buffer, size_t length, size_t offset)
+{
+    if ((length > INT_MAX) || (offset > INT_MAX))
+        return SQLITE_TOOBIG;
+
+    return sqlite3_blob_write(m_handle, buffer, (int)length, (int)offset);
+}
+
+int blob_stream::reopen(int64_t rowid)
+{
+    return sqlite3_blob_reopen(m_handle, rowid);
+}
+
+size_t blob_stream::size() const
+{
+    return (m_handle != nullptr)
+        ? (size_t)sqlite3_blob_bytes(m_handle)
+        : 0;
+}
+
+int blob_stream::close()
+{
+    int code = SQLITE_OK;
+    if (m_handle != nullptr)
+    {
+        // the handle is released even if closing reports an error
+        code = sqlite3_blob_close(m_handle);
+        m_handle = nullptr;
+    }
+
+    return code;
+}
+
+} // sqlitepp
@@ -0,0 +1,66 @@
+#include "sqlitepp_bulk.h"
+
+namespace sqlitepp
+{
+
+namespace detail
+{
+    std::string make_insert_sql(const char* table, const char* const* columns, size_t column_count, size_t rows)
+    {
+        std::string sql = "INSERT INTO ";
+        sql.reserve(sql.size() + strlen(table) + column_count * (16 + rows * 2) + rows * 3);
+
+        sql += table;
+        sql += " (";
+        for (size_t i = 0; i < column_count; ++i)
+        {
+            if (i != 0)
+            {
+                sql += ',';
+            }
+
+            sql += columns[i];
+        }
+
+        sql += ") VALUES ";
+        for (size_t row = 0; row < rows; ++row)
+        {
+            sql += (row == 0) ? "(" : ",(";
+            for (size_t i = 0; i < column_count; ++i)
+            {
+                sql += (i == 0) ? "?" : ",?";
+            }
+
+            sql += ')';
+        }
+
+        return sql;
+    }
+
+    std::vector<size_t> make_batch_sizes(size_t column_count, size_t max_variables)
+    {
+        static const size_t candidates[] = { 256, 64, 16, 4, 1 };
+
+        const auto max_rows = (column_count > 0) ? (max_variables / column_count) : 0;
+
+        std::vector<size_t> sizes;
+        for (const auto rows : candidates)
+        {
+            const auto clamped = (rows < max_rows) ? rows : max_rows;
+            if ((clamped > 0) && (sizes.empty() || (sizes.back() > clamped)))
+            {
+                sizes.push_back(clamped);
+            }
+        }
+
+        // single row inserts are always possible
+        if (sizes.empty() || (sizes.back() != 1))
+        {
+            sizes.push_back(1);
+        }
+
+        return sizes;
+    }
+}
+
+} // sqlitepp
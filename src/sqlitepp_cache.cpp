@@ -0,0 +1,189 @@
+#include "sqlitepp_cache.h"
+
+#include <cassert>
+
+namespace sqlitepp
+{
+
+namespace detail
+{
+    size_t sql_key_hash::operator()(const sql_key& key) const noexcept
+    {
+        // FNV-1a
+        uint64_t hash = 14695981039346656037ULL;
+        for (size_t i = 0; i < key.length; ++i)
+        {
+            hash ^= static_cast<unsigned char>(key.text[i]);
+            hash *= 1099511628211ULL;
+        }
+
+        return static_cast<size_t>(hash);
+    }
+}
+
+constexpr size_t statement_cache::default_capacity;
+
+cached_statement::cached_statement(cached_statement&& other) noexcept
+    : m_cache(std::move(other.m_cache)),
+    m_entry(other.m_entry)
+{
+    other.m_entry = nullptr;
+}
+
+cached_statement& cached_statement::operator=(cached_statement&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+
+        m_cache = std::move(other.m_cache);
+        m_entry = other.m_entry;
+
+        other.m_entry = nullptr;
+    }
+
+    return *this;
+}
+
+cached_statement::~cached_statement()
+{
+    release();
+}
+
+void cached_statement::release()
+{
+    if (m_entry != nullptr)
+    {
+        if (m_entry->detached)
+        {
+            --m_cache->m_leases;
+            delete m_entry;
+        }
+        else
+        {
+            m_cache->release(m_entry);
+        }
+
+        // the last lease of a cache whose database is gone takes it down here
+        m_entry = nullptr;
+        m_cache.reset();
+    }
+}
+
+statement_cache::statement_cache(sqlite3* handle, size_t capacity) noexcept
+    : m_handle(handle),
+    m_capacity(capacity)
+{
+}
+
+statement_cache::~statement_cache()
+{
+    // every lease holds on to the cache
+    assert(m_leases == 0);
+    clear();
+}
+
+cached_statement statement_cache::acquire(const char* query)
+{
+    const size_t length = strlen(query);
+
+    const auto it = m_lookup.find(detail::sql_key{ query, length });
+    if ((it != m_lookup.end()) && !it->second->in_use)
+    {
+        ++m_stats.hits;
+
+        // move to the front of the LRU list
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        it->second->in_use = true;
+        ++m_leases;
+
+        return cached_statement(shared_from_this(), &*it->second);
+    }
+
+    ++m_stats.misses;
+
+    statement stmt;
+    if (prepare(query, length, stmt) != SQLITE_OK)
+    {
+        return cached_statement();
+    }
+
+    // the same query is already leased (or caching is disabled),
+    // so this one is finalized when the lease goes away
+    if ((it != m_lookup.end()) || (m_capacity == 0))
+    {
+        auto* entry = new detail::cache_entry(std::string(query, length), std::move(stmt));
+        entry->in_use = true;
+        entry->detached = true;
+        ++m_leases;
+
+        return cached_statement(shared_from_this(), entry);
+    }
+
+    m_entries.emplace_front(std::string(query, length), std::move(stmt));
+
+    auto& entry = m_entries.front();
+    entry.in_use = true;
+    ++m_leases;
+
+    m_lookup.emplace(detail::sql_key{ entry.sql.data(), entry.sql.length() }, m_entries.begin());
+    evict();
+
+    return cached_statement(shared_from_this(), &entry);
+}
+
+void statement_cache::clear()
+{
+    // leased statements stay alive until they're released
+    for (auto it = m_entries.begin(); it != m_entries.end();)
+    {
+        if (!it->in_use)
+        {
+            m_lookup.erase(detail::sql_key{ it->sql.data(), it->sql.length() });
+            it = m_entries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void statement_cache::set_capacity(size_t capacity)
+{
+    m_capacity = capacity;
+    evict();
+}
+
+int statement_cache::prepare(const char* query, size_t length, statement& stmt) const
+{
+    return sqlite3_prepare_v3(m_handle, query, (int)length, SQLITE_PREPARE_PERSISTENT, &stmt.m_handle, nullptr);
+}
+
+void statement_cache::release(detail::cache_entry* entry)
+{
+    entry->stmt.reset();
+    entry->stmt.clear_bindings();
+
+    entry->in_use = false;
+    --m_leases;
+    evict();
+}
+
+void statement_cache::evict()
+{
+    auto it = m_entries.end();
+    while ((m_lookup.size() > m_capacity) && (it != m_entries.begin()))
+    {
+        --it;
+        if (!it->in_use)
+        {
+            ++m_stats.evictions;
+
+            m_lookup.erase(detail::sql_key{ it->sql.data(), it->sql.length() });
+            it = m_entries.erase(it);
+        }
+    }
+}
+
+} // sqlitepp
@@ -0,0 +1,46 @@
+#include "sqlitepp_config.h"
+
+namespace sqlitepp
+{
+
+int global_config::initialize()
+{
+    return sqlite3_initialize();
+}
+
+int global_config::shutdown()
+{
+    return sqlite3_shutdown();
+}
+
+int global_config::set_allocator(const sqlite3_mem_methods& methods)
+{
+    return sqlite3_config(SQLITE_CONFIG_MALLOC, &methods);
+}
+
+int global_config::get_allocator(sqlite3_mem_methods& methods)
+{
+    return sqlite3_config(SQLITE_CONFIG_GETMALLOC, &methods);
+}
+
+int global_config::set_memory_status(bool enabled)
+{
+    return sqlite3_config(SQLITE_CONFIG_MEMSTATUS, enabled ? 1 : 0);
+}
+
+int global_config::set_page_cache(void* buffer, int page_size, int pages)
+{
+    return sqlite3_config(SQLITE_CONFIG_PAGECACHE, buffer, page_size, pages);
+}
+
+int global_config::set_heap(void* buffer, int size, int min_allocation)
+{
+    return sqlite3_config(SQLITE_CONFIG_HEAP, buffer, size, min_allocation);
+}
+
+int global_config::set_lookaside(int slot_size, int slots)
+{
+    return sqlite3_config(SQLITE_CONFIG_LOOKASIDE, slot_size, slots);
+}
+
+} // sqlitepp
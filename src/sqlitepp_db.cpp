@@ -1,8 +1,42 @@
 #include "sqlitepp_db.h"
+#include "sqlitepp_array.h"
 
 namespace sqlitepp
 {
 
+namespace
+{
+    int trace_callback(unsigned type, void* context, void* p, void* x)
+    {
+        const auto* hooks = static_cast<const detail::trace_hooks*>(context);
+        auto* stmt = static_cast<sqlite3_stmt*>(p);
+
+        if ((hooks->stats != nullptr) && (type == SQLITE_TRACE_PROFILE))
+        {
+            hooks->stats->record(stmt);
+        }
+
+        if (hooks->profile != nullptr)
+        {
+            if (type == SQLITE_TRACE_STMT)
+            {
+                // trigger programs report "-- name" on the same statement, keep the outer start time
+                const auto* text = static_cast<const char*>(x);
+                if ((text == nullptr) || (text[0] != '-') || (text[1] != '-'))
+                {
+                    hooks->profile->begin(stmt);
+                }
+            }
+            else if (type == SQLITE_TRACE_PROFILE)
+            {
+                hooks->profile->end(stmt);
+            }
+        }
+
+        return 0;
+    }
+}
+
 database::database(const char* db)
 {
     assert(open(db, SQLITE_OPEN_READWRITE) == SQLITE_OK);
@@ -25,7 +59,9 @@ database::database(const std::string& db, int& result)
 
 database::database(database&& other) noexcept
     : m_handle(other.m_handle),
-    m_extended_result_codes(other.m_extended_result_codes)
+    m_extended_result_codes(other.m_extended_result_codes),
+    m_cache(std::move(other.m_cache)),
+    m_trace(std::move(other.m_trace))
 {
     other.m_handle = nullptr;
 }
@@ -38,6 +74,8 @@ database& database::operator=(database&& other) noexcept
         other.m_handle = nullptr;
 
         m_extended_result_codes = other.m_extended_result_codes;
+        m_cache = std::move(other.m_cache);
+        m_trace = std::move(other.m_trace);
     }
 
     return *this;
@@ -45,7 +83,18 @@ database& database::operator=(database&& other) noexcept
 
 database::~database()
 {
-    close();
+    if (close() != SQLITE_OK)
+    {
+        // statements are still out, e.g. leases from prepare_cached; SQLite closes
+        // the connection once the last of them is finalized, the trace hooks go now
+        sqlite3_trace_v2(m_handle, 0, nullptr, nullptr);
+        if (m_cache)
+        {
+            m_cache->clear();
+        }
+
+        sqlite3_close_v2(m_handle);
+    }
 }
 
 int database::open(const std::string& db, int flags)
@@ -55,17 +104,37 @@ int database::open(const std::string& db, int flags)
 
 int database::open(const char* db, int flags)
 {
-    return sqlite3_open_v2(db, &m_handle, flags, nullptr);
+    const auto code = sqlite3_open_v2(db, &m_handle, flags, nullptr);
+    if (code == SQLITE_OK)
+    {
+        m_cache = std::make_shared<statement_cache>(m_handle);
+    }
+
+    return code;
 }
 
 int database::close()
 {
     if (m_handle != nullptr)
     {
+        // cached statements would keep the connection busy,
+        // and leased ones are still in use
+        if (m_cache)
+        {
+            if (m_cache->get_leases() != 0)
+            {
+                return SQLITE_BUSY;
+            }
+
+            m_cache->clear();
+        }
+
         const auto code = sqlite3_close(m_handle);
         if (code == SQLITE_OK)
         {
             m_handle = nullptr;
+            m_cache.reset();
+            m_trace.reset();
         }
 
         return code;
@@ -84,11 +153,139 @@ statement database::prepare(const char* query) const
     return stmt;
 }
 
+cached_statement database::prepare_cached(const char* query) const
+{
+    if (!m_cache)
+    {
+        return cached_statement();
+    }
+
+    return m_cache->acquire(query);
+}
+
+int database::execute_cached(const char* query) const
+{
+    cached_statement stmt = prepare_cached(query);
+    if (!stmt.ok())
+    {
+        return get_last_error();
+    }
+
+    return stmt->execute();
+}
+
+statement_cache* database::get_statement_cache() const
+{
+    return m_cache.get();
+}
+
 int database::execute(const char* query) const
 {
     return sqlite3_exec(m_handle, query, nullptr, nullptr, nullptr);
 }
 
+int database::create_array_module(const char* name)
+{
+    return sqlite3_create_module_v2(m_handle, name, detail::get_array_module(), nullptr, nullptr);
+}
+
+int database::execute_script(const char* sql) const
+{
+    script runner(m_handle, sql, false);
+    return runner.run();
+}
+
+script database::compile_script(const char* sql) const
+{
+    return script(m_handle, sql, true);
+}
+
+blob_stream database::open_blob(const char* table, const char* column, int64_t rowid, bool writable) const
+{
+    return open_blob("main", table, column, rowid, writable);
+}
+
+blob_stream database::open_blob(const char* db, const char* table, const char* column, int64_t rowid, bool writable) const
+{
+    blob_stream stream;
+    sqlite3_blob_open(m_handle, db, table, column, rowid, writable ? 1 : 0, &stream.m_handle);
+
+    return stream;
+}
+
+int database::enable_profiling(query_profiler& profiler)
+{
+    if (!m_trace)
+    {
+        m_trace.reset(new detail::trace_hooks());
+    }
+
+    if (m_trace->profiler != &profiler)
+    {
+        m_trace->profiler = &profiler;
+        m_trace->attached_profile = profiler.attach();
+    }
+
+    m_trace->profile = m_trace->attached_profile;
+    return update_trace();
+}
+
+int database::disable_profiling()
+{
+    if (m_trace)
+    {
+        m_trace->profile = nullptr;
+    }
+
+    return update_trace();
+}
+
+int database::enable_statement_stats(stats_registry& registry)
+{
+    if (!m_trace)
+    {
+        m_trace.reset(new detail::trace_hooks());
+    }
+
+    if (m_trace->registry != &registry)
+    {
+        m_trace->registry = &registry;
+        m_trace->attached_stats = registry.attach();
+    }
+
+    m_trace->stats = m_trace->attached_stats;
+    return update_trace();
+}
+
+int database::disable_statement_stats()
+{
+    if (m_trace)
+    {
+        m_trace->stats = nullptr;
+    }
+
+    return update_trace();
+}
+
+int database::update_trace()
+{
+    unsigned mask = 0;
+    if (m_trace)
+    {
+        if (m_trace->profile != nullptr)
+        {
+            mask |= SQLITE_TRACE_STMT | SQLITE_TRACE_PROFILE;
+        }
+
+        if (m_trace->stats != nullptr)
+        {
+            mask |= SQLITE_TRACE_PROFILE;
+        }
+    }
+
+    return sqlite3_trace_v2(m_handle, mask, (mask != 0) ? &trace_callback : nullptr, m_trace.get());
+}
+
 int database::toggle_extended_result_codes()
 {
     m_extended_result_codes = !m_extended_result_codes;
@@ -100,4 +297,27 @@ bool database::is_using_extended_result_codes() const
     return m_extended_result_codes;
 }
 
+int database::get_last_error() const
+{
+    return m_extended_result_codes
+        ? sqlite3_extended_errcode(m_handle)
+        : sqlite3_errcode(m_handle);
+}
+
+int database::get_limit(int id) const
+{
+    return sqlite3_limit(m_handle, id, -1);
+}
+
+int database::set_limit(int id, int value)
+{
+    // returns the previous value
+    return sqlite3_limit(m_handle, id, value);
+}
+
+int database::set_busy_timeout(int milliseconds)
+{
+    return sqlite3_busy_timeout(m_handle, milliseconds);
+}
+
 } // sqlitepp
@@ -0,0 +1,150 @@
+#include "sqlitepp_function.h"
+
+#include <exception>
+
+namespace sqlitepp
+{
+
+namespace detail
+{
+    int read_value(sqlite3_value* value, int32_t& result)
+    {
+        if (sqlite3_value_type(value) != SQLITE_INTEGER)
+            return SQLITE_MISMATCH;
+
+        result = sqlite3_value_int(value);
+        return SQLITE_OK;
+    }
+
+    int read_value(sqlite3_value* value, int64_t& result)
+    {
+        if (sqlite3_value_type(value) != SQLITE_INTEGER)
+            return SQLITE_MISMATCH;
+
+        result = sqlite3_value_int64(value);
+        return SQLITE_OK;
+    }
+
+    int read_value(sqlite3_value* value, double& result)
+    {
+        if (sqlite3_value_type(value) != SQLITE_FLOAT)
+            return SQLITE_MISMATCH;
+
+        result = sqlite3_value_double(value);
+        return SQLITE_OK;
+    }
+
+    int read_value(sqlite3_value* value, std::string& result)
+    {
+        if (sqlite3_value_type(value) != SQLITE_TEXT)
+            return SQLITE_MISMATCH;
+
+        const auto* ptr = reinterpret_cast<const char*>(sqlite3_value_text(value));
+        result.assign(ptr, (size_t)sqlite3_value_bytes(value));
+        return SQLITE_OK;
+    }
+
+    int read_value(sqlite3_value* value, std::vector<char>& result)
+    {
+        if (sqlite3_value_type(value) != SQLITE_BLOB)
+            return SQLITE_MISMATCH;
+
+        const auto* ptr = static_cast<const char*>(sqlite3_value_blob(value));
+        result.assign(ptr, ptr + sqlite3_value_bytes(value));
+        return SQLITE_OK;
+    }
+
+    int read_value(sqlite3_value* value, text_view& result)
+    {
+        if (sqlite3_value_type(value) != SQLITE_TEXT)
+            return SQLITE_MISMATCH;
+
+        result.ptr = reinterpret_cast<const char*>(sqlite3_value_text(value));
+        result.length = (size_t)sqlite3_value_bytes(value);
+        return SQLITE_OK;
+    }
+
+    int read_value(sqlite3_value* value, blob_view& result)
+    {
+        if (sqlite3_value_type(value) != SQLITE_BLOB)
+            return SQLITE_MISMATCH;
+
+        result.ptr = sqlite3_value_blob(value);
+        result.length = (size_t)sqlite3_value_bytes(value);
+        return SQLITE_OK;
+    }
+
+    bool has_null(int argc, sqlite3_value** argv)
+    {
+        for (int i = 0; i < argc; ++i)
+        {
+            if (sqlite3_value_type(argv[i]) == SQLITE_NULL)
+                return true;
+        }
+
+        return false;
+    }
+
+    void result_exception(sqlite3_context* context)
+    {
+        try
+        {
+            throw;
+        }
+        catch (const std::exception& e)
+        {
+            sqlite3_result_error(context, e.what(), -1);
+        }
+        catch (...)
+        {
+            sqlite3_result_error(context, "exception thrown by a user defined function", -1);
+        }
+    }
+
+    void set_result(sqlite3_context* context, std::nullptr_t)
+    {
+        sqlite3_result_null(context);
+    }
+
+    void set_result(sqlite3_context* context, int32_t value)
+    {
+        sqlite3_result_int(context, value);
+    }
+
+    void set_result(sqlite3_context* context, int64_t value)
+    {
+        sqlite3_result_int64(context, value);
+    }
+
+    void set_result(sqlite3_context* context, double value)
+    {
+        sqlite3_result_double(context, value);
+    }
+
+    void set_result(sqlite3_context* context, const char* value)
+    {
+        sqlite3_result_text(context, value, -1, SQLITE_TRANSIENT);
+    }
+
+    void set_result(sqlite3_context* context, const std::string& value)
+    {
+        sqlite3_result_text64(context, value.data(), (sqlite3_uint64)value.length(), SQLITE_TRANSIENT, SQLITE_UTF8);
+    }
+
+    void set_result(sqlite3_context* context, const std::vector<char>& value)
+    {
+        sqlite3_result_blob64(context, value.data(), (sqlite3_uint64)value.size(), SQLITE_TRANSIENT);
+    }
+
+    void set_result(sqlite3_context* context, const text_view& value)
+    {
+        sqlite3_result_text64(context, value.ptr, (sqlite3_uint64)value.length, SQLITE_TRANSIENT, SQLITE_UTF8);
+    }
+
+    void set_result(sqlite3_context* context, const blob_view& value)
+    {
+        sqlite3_result_blob64(context, value.ptr, (sqlite3_uint64)value.length, SQLITE_TRANSIENT);
+    }
+}
+
+} // sqlitepp
@@ -0,0 +1,256 @@
+#include "sqlitepp_pool.h"
+
+namespace sqlitepp
+{
+
+connection_lease::connection_lease(connection_lease&& other) noexcept
+    : m_pool(other.m_pool),
+    m_db(other.m_db),
+    m_writer(other.m_writer)
+{
+    other.m_pool = nullptr;
+    other.m_db = nullptr;
+}
+
+connection_lease& connection_lease::operator=(connection_lease&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+
+        m_pool = other.m_pool;
+        m_db = other.m_db;
+        m_writer = other.m_writer;
+
+        other.m_pool = nullptr;
+        other.m_db = nullptr;
+    }
+
+    return *this;
+}
+
+connection_lease::~connection_lease()
+{
+    release();
+}
+
+void connection_lease::release()
+{
+    if (m_db != nullptr)
+    {
+        m_pool->release(m_db, m_writer);
+
+        m_pool = nullptr;
+        m_db = nullptr;
+    }
+}
+
+pooled_statement& pooled_statement::operator=(pooled_statement&& other) noexcept
+{
+    if (this != &other)
+    {
+        // give the statement back before the connection it belongs to
+        m_stmt = std::move(other.m_stmt);
+        m_lease = std::move(other.m_lease);
+    }
+
+    return *this;
+}
+
+connection_pool::connection_pool(const char* db, size_t readers, int& result)
+{
+    result = open(db, readers);
+}
+
+connection_pool::~connection_pool()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_all_released.wait(lock, [this]() { return m_leases == 0; });
+    }
+
+    close();
+}
+
+int connection_pool::open(const char* db, size_t readers)
+{
+    // every connection is used by one thread at a time, so SQLite's own mutex isn't needed
+    const int writer_flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX;
+    const int reader_flags = SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX;
+
+    std::unique_ptr<database> writer(new database());
+
+    auto code = writer->open(db, writer_flags);
+    if (code == SQLITE_OK)
+    {
+        // readers only run concurrently with the writer in WAL mode
+        code = writer->execute("PRAGMA journal_mode=WAL");
+    }
+
+    if (code != SQLITE_OK)
+    {
+        return code;
+    }
+
+    std::vector<std::unique_ptr<database>> reader_connections;
+    for (size_t i = 0; i < readers; ++i)
+    {
+        std::unique_ptr<database> reader(new database());
+
+        code = reader->open(db, reader_flags);
+        if (code != SQLITE_OK)
+        {
+            return code;
+        }
+
+        reader_connections.push_back(std::move(reader));
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // the connections being replaced are still in use
+    if (m_leases != 0)
+    {
+        return SQLITE_BUSY;
+    }
+
+    m_writer = std::move(writer);
+    m_writer_busy = false;
+
+    m_readers = std::move(reader_connections);
+    m_idle_readers.clear();
+    for (const auto& reader : m_readers)
+    {
+        m_idle_readers.push_back(reader.get());
+    }
+
+    return SQLITE_OK;
+}
+
+int connection_pool::close()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // a leased connection may be in use on another thread right now
+    if (m_leases != 0)
+    {
+        return SQLITE_BUSY;
+    }
+
+    int code = SQLITE_OK;
+    for (const auto& reader : m_readers)
+    {
+        const auto reader_code = reader->close();
+        if (reader_code != SQLITE_OK)
+        {
+            code = reader_code;
+        }
+    }
+
+    if (m_writer)
+    {
+        const auto writer_code = m_writer->close();
+        if (writer_code != SQLITE_OK)
+        {
+            code = writer_code;
+        }
+    }
+
+    if (code == SQLITE_OK)
+    {
+        m_writer.reset();
+        m_writer_busy = false;
+
+        m_readers.clear();
+        m_idle_readers.clear();
+    }
+
+    return code;
+}
+
+connection_lease connection_pool::acquire_writer()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return acquire_writer(lock);
+}
+
+connection_lease connection_pool::acquire_reader()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_readers.empty())
+    {
+        return acquire_writer(lock);
+    }
+
+    m_reader_released.wait(lock, [this]() { return !m_idle_readers.empty(); });
+
+    auto* reader = m_idle_readers.back();
+    m_idle_readers.pop_back();
+    ++m_leases;
+
+    return connection_lease(this, reader, false);
+}
+
+connection_lease connection_pool::acquire_writer(std::unique_lock<std::mutex>& lock)
+{
+    if (!m_writer)
+    {
+        return connection_lease();
+    }
+
+    m_writer_released.wait(lock, [this]() { return !m_writer_busy; });
+    m_writer_busy = true;
+    ++m_leases;
+
+    return connection_lease(this, m_writer.get(), true);
+}
+
+pooled_statement connection_pool::prepare(const char* query)
+{
+    connection_lease lease = acquire_reader();
+    if (!lease.ok())
+    {
+        return pooled_statement();
+    }
+
+    cached_statement stmt = lease->prepare_cached(query);
+    if (stmt.ok() && !lease.is_writer() && !stmt->is_readonly())
+    {
+        // writes have to go through the writer
+        stmt.release();
+        lease.release();
+
+        lease = acquire_writer();
+        stmt = lease->prepare_cached(query);
+    }
+
+    if (!stmt.ok())
+    {
+        return pooled_statement();
+    }
+
+    return pooled_statement(std::move(lease), std::move(stmt));
+}
+
+void connection_pool::release(database* db, bool writer)
+{
+    // notified under the lock, the destructor may free the pool as soon as it's let go
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (writer)
+    {
+        m_writer_busy = false;
+        m_writer_released.notify_one();
+    }
+    else
+    {
+        m_idle_readers.push_back(db);
+        m_reader_released.notify_one();
+    }
+
+    if (--m_leases == 0)
+    {
+        m_all_released.notify_all();
+    }
+}
+
+} // sqlitepp
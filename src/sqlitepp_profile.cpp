@@ -0,0 +1,205 @@
+#include "sqlitepp_profile.h"
+
+namespace sqlitepp
+{
+
+namespace
+{
+    size_t highest_bit(uint64_t value)
+    {
+        size_t bit = 0;
+        for (size_t shift = 32; shift > 0; shift /= 2)
+        {
+            if ((value >> shift) != 0)
+            {
+                value >>= shift;
+                bit += shift;
+            }
+        }
+
+        return bit;
+    }
+}
+
+uint64_t histogram_snapshot::percentile(double p) const
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    auto target = (uint64_t)((p / 100.0) * (double)count + 0.5);
+    if (target == 0)
+    {
+        target = 1;
+    }
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i)
+    {
+        seen += buckets[i];
+        if (seen >= target)
+        {
+            const auto bound = latency_histogram::bucket_upper_bound(i);
+            return (bound < max_ns) ? bound : max_ns;
+        }
+    }
+
+    return max_ns;
+}
+
+double histogram_snapshot::mean() const
+{
+    return (count != 0)
+        ? (double)total_ns / (double)count
+        : 0.0;
+}
+
+void histogram_snapshot::merge(const histogram_snapshot& other)
+{
+    if (buckets.size() < other.buckets.size())
+    {
+        buckets.resize(other.buckets.size());
+    }
+
+    for (size_t i = 0; i < other.buckets.size(); ++i)
+    {
+        buckets[i] += other.buckets[i];
+    }
+
+    count += other.count;
+    total_ns += other.total_ns;
+    if (other.max_ns > max_ns)
+    {
+        max_ns = other.max_ns;
+    }
+}
+
+constexpr size_t latency_histogram::sub_bucket_bits;
+constexpr size_t latency_histogram::sub_bucket_count;
+constexpr size_t latency_histogram::bucket_count;
+
+latency_histogram::latency_histogram() noexcept
+    : m_count(0),
+    m_total_ns(0),
+    m_max_ns(0)
+{
+    for (auto& bucket : m_buckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+void latency_histogram::record(uint64_t nanoseconds)
+{
+    auto& bucket = m_buckets[bucket_index(nanoseconds)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    m_count.store(m_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    m_total_ns.store(m_total_ns.load(std::memory_order_relaxed) + nanoseconds, std::memory_order_relaxed);
+
+    if (nanoseconds > m_max_ns.load(std::memory_order_relaxed))
+    {
+        m_max_ns.store(nanoseconds, std::memory_order_relaxed);
+    }
+}
+
+histogram_snapshot latency_histogram::snapshot() const
+{
+    histogram_snapshot result;
+    result.buckets.resize(bucket_count);
+
+    for (size_t i = 0; i < bucket_count; ++i)
+    {
+        result.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+    }
+
+    result.count = m_count.load(std::memory_order_relaxed);
+    result.total_ns = m_total_ns.load(std::memory_order_relaxed);
+    result.max_ns = m_max_ns.load(std::memory_order_relaxed);
+
+    return result;
+}
+
+size_t latency_histogram::bucket_index(uint64_t value)
+{
+    // the first sub_bucket_count values get a bucket each
+    if (value < sub_bucket_count)
+    {
+        return (size_t)value;
+    }
+
+    const auto bit = highest_bit(value);
+    const auto shift = bit - sub_bucket_bits;
+
+    return (bit - sub_bucket_bits + 1) * sub_bucket_count +
+           (size_t)((value >> shift) & (sub_bucket_count - 1));
+}
+
+uint64_t latency_histogram::bucket_upper_bound(size_t index)
+{
+    if (index < sub_bucket_count)
+    {
+        return index;
+    }
+
+    const auto shift = index / sub_bucket_count - 1;
+    const auto sub_bucket = (uint64_t)(sub_bucket_count + index % sub_bucket_count);
+
+    // last value that still maps to this bucket
+    return ((sub_bucket + 1) << shift) - 1;
+}
+
+namespace detail
+{
+    void connection_profile::begin(sqlite3_stmt* stmt)
+    {
+        const char* sql = sqlite3_sql(stmt);
+        if (sql == nullptr)
+        {
+            return;
+        }
+
+        state(stmt, sql).first->start = std::chrono::steady_clock::now();
+    }
+
+    void connection_profile::end(sqlite3_stmt* stmt)
+    {
+        const auto now = std::chrono::steady_clock::now();
+
+        const auto* profile = find(stmt);
+        if (profile == nullptr)
+        {
+            return;
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - profile->start);
+        profile->slot->latency.record((uint64_t)elapsed.count());
+
+        // only begin() to end() has to be matched up, finalized statements don't linger
+        forget(stmt);
+    }
+}
+
+std::vector<query_latency> query_profiler::snapshot() const
+{
+    std::unordered_map<std::string, histogram_snapshot> merged;
+    m_connections.for_each_slot([&merged](const std::string& sql, const detail::profile_slot& slot)
+    {
+        merged[sql].merge(slot.latency.snapshot());
+    });
+
+    std::vector<query_latency> result;
+    result.reserve(merged.size());
+
+    for (auto& query : merged)
+    {
+        result.push_back(query_latency());
+        result.back().sql = query.first;
+        result.back().latency = std::move(query.second);
+    }
+
+    return result;
+}
+
+} // sqlitepp
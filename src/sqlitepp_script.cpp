@@ -0,0 +1,79 @@
+#include "sqlitepp_script.h"
+
+namespace sqlitepp
+{
+
+script::script(sqlite3* handle, const char* sql, bool persistent)
+    : m_handle(handle),
+    m_sql(sql),
+    m_persistent(persistent)
+{
+}
+
+script::script(script&& other) noexcept
+    : m_handle(other.m_handle),
+    m_sql(std::move(other.m_sql)),
+    m_offset(other.m_offset),
+    m_persistent(other.m_persistent),
+    m_compiled(other.m_compiled),
+    m_statements(std::move(other.m_statements))
+{
+    other.m_handle = nullptr;
+}
+
+script& script::operator=(script&& other) noexcept
+{
+    if (this != &other)
+    {
+        m_handle = other.m_handle;
+        other.m_handle = nullptr;
+
+        m_sql = std::move(other.m_sql);
+        m_offset = other.m_offset;
+        m_persistent = other.m_persistent;
+        m_compiled = other.m_compiled;
+        m_statements = std::move(other.m_statements);
+    }
+
+    return *this;
+}
+
+int script::run()
+{
+    return run(detail::script_no_binder(), detail::script_no_rows());
+}
+
+int script::prepare_next(bool& found)
+{
+    const unsigned int flags = m_persistent ? SQLITE_PREPARE_PERSISTENT : 0;
+
+    // whitespace and comments between statements prepare to a null handle
+    while (m_offset < m_sql.length())
+    {
+        const char* begin = m_sql.c_str() + m_offset;
+        const char* tail = nullptr;
+
+        statement stmt;
+        const auto code = sqlite3_prepare_v3(m_handle, begin, (int)(m_sql.length() - m_offset) + 1,
+            flags, &stmt.m_handle, &tail);
+        if (code != SQLITE_OK)
+        {
+            return code;
+        }
+
+        m_offset = (tail != nullptr) ? (size_t)(tail - m_sql.c_str()) : m_sql.length();
+
+        if (stmt.ok())
+        {
+            m_statements.push_back(std::move(stmt));
+            found = true;
+
+            return SQLITE_OK;
+        }
+    }
+
+    found = false;
+    return SQLITE_OK;
+}
+
+} // sqlitepp
@@ -0,0 +1,127 @@
+#include "sqlitepp_stats.h"
+
+namespace sqlitepp
+{
+
+namespace
+{
+    void accumulate(query_stats& target, const statement_counters& counters, uint64_t memory_used)
+    {
+        target.totals.fullscan_steps += counters.fullscan_steps;
+        target.totals.sorts += counters.sorts;
+        target.totals.autoindexes += counters.autoindexes;
+        target.totals.vm_steps += counters.vm_steps;
+        target.totals.reprepares += counters.reprepares;
+        target.totals.runs += counters.runs;
+
+        if (memory_used > target.max_memory_used)
+        {
+            target.max_memory_used = memory_used;
+        }
+    }
+
+    statement_counters statement_counters_of(sqlite3_stmt* stmt)
+    {
+        statement_counters counters;
+        counters.fullscan_steps = (uint64_t)sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_FULLSCAN_STEP, 0);
+        counters.sorts = (uint64_t)sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_SORT, 0);
+        counters.autoindexes = (uint64_t)sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_AUTOINDEX, 0);
+        counters.vm_steps = (uint64_t)sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_VM_STEP, 0);
+        counters.reprepares = (uint64_t)sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_REPREPARE, 0);
+        counters.runs = (uint64_t)sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_RUN, 0);
+        counters.memory_used = (uint64_t)sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_MEMUSED, 0);
+
+        return counters;
+    }
+
+    // every run bumps SQLITE_STMTSTATUS_RUN before it's recorded, so a run count
+    // that didn't grow is a new statement at a reused address or counters reset by the user
+    bool restarted(const statement_counters& current, const statement_counters& last)
+    {
+        return current.runs <= last.runs;
+    }
+
+    uint64_t since(uint64_t current, uint64_t last)
+    {
+        return (current >= last) ? current - last : current;
+    }
+}
+
+namespace detail
+{
+    void connection_stats::record(sqlite3_stmt* stmt)
+    {
+        const char* sql = sqlite3_sql(stmt);
+        if (sql == nullptr)
+        {
+            return;
+        }
+
+        const statement_counters current = statement_counters_of(stmt);
+
+        // the first run of this statement, or a restart of it
+        const auto entry = state(stmt, sql);
+        auto& last = entry.first->last;
+        if (!entry.second && restarted(current, last))
+        {
+            last = statement_counters();
+        }
+
+        // only the work of this run
+        statement_counters counters;
+        counters.fullscan_steps = since(current.fullscan_steps, last.fullscan_steps);
+        counters.sorts = since(current.sorts, last.sorts);
+        counters.autoindexes = since(current.autoindexes, last.autoindexes);
+        counters.vm_steps = since(current.vm_steps, last.vm_steps);
+        counters.reprepares = since(current.reprepares, last.reprepares);
+        counters.runs = since(current.runs, last.runs);
+
+        last = current;
+
+        // the totals are read by snapshot()
+        std::lock_guard<std::mutex> lock(mutex);
+        accumulate(entry.first->slot->stats, counters, current.memory_used);
+    }
+}
+
+std::vector<query_stats> stats_registry::snapshot() const
+{
+    std::unordered_map<std::string, query_stats> merged;
+    m_connections.for_each_slot([&merged](const std::string& sql, const detail::stats_slot& slot)
+    {
+        accumulate(merged[sql], slot.stats.totals, slot.stats.max_memory_used);
+    });
+
+    std::vector<query_stats> result;
+    result.reserve(merged.size());
+
+    for (auto& query : merged)
+    {
+        query.second.sql = query.first;
+        result.push_back(std::move(query.second));
+    }
+
+    return result;
+}
+
+std::vector<query_stats> stats_registry::flagged() const
+{
+    auto result = snapshot();
+
+    auto it = result.begin();
+    while (it != result.end())
+    {
+        if (it->has_full_scans() || it->has_automatic_indexes())
+        {
+            ++it;
+        }
+        else
+        {
+            it = result.erase(it);
+        }
+    }
+
+    return result;
+}
+
+} // sqlitepp
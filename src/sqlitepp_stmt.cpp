@@ -1,165 +1,235 @@
 #include "sqlitepp_stmt.h"
 
+#ifndef SQLITEPP_INLINE_BINDINGS
+#include "sqlitepp_stmt.inl"
+#endif // SQLITEPP_INLINE_BINDINGS
+
 namespace sqlitepp
 {
 
-namespace detail
+statement::statement(statement&& other) noexcept
+    : m_handle(other.m_handle),
+    m_bind_index(other.m_bind_index),
+    m_read_index(other.m_read_index),
+    m_exec_status(other.m_exec_status),
+    m_exec_before_next_row(other.m_exec_before_next_row),
+    m_named_parameters(std::move(other.m_named_parameters)),
+    m_named_parameters_built(other.m_named_parameters_built),
+    m_owned_values(std::move(other.m_owned_values))
 {
-    int bind(sqlite3_stmt* stmt, int index, int32_t value)
-    {
-        return sqlite3_bind_int(stmt, index, value);
-    }
+    other.m_handle = nullptr;
+}
 
-    int bind(sqlite3_stmt* stmt, int index, int64_t value)
+statement& statement::operator=(statement&& other) noexcept
+{
+    if (this != &other)
     {
-        return sqlite3_bind_int64(stmt, index, value);
-    }
+        m_handle = other.m_handle;
+        other.m_handle = nullptr;
 
-    int bind(sqlite3_stmt* stmt, int index, double value)
-    {
-        return sqlite3_bind_double(stmt, index, value);
-    }
+        m_bind_index = other.m_bind_index;
+        m_read_index = other.m_read_index;
+        m_exec_status = other.m_exec_status;
+        m_exec_before_next_row = other.m_exec_before_next_row;
 
-    int bind(sqlite3_stmt* stmt, int index, const char* value)
-    {
-        return sqlite3_bind_text(stmt, index, value, (int)strlen(value), SQLITE_STATIC);
+        m_named_parameters = std::move(other.m_named_parameters);
+        m_named_parameters_built = other.m_named_parameters_built;
+        m_owned_values = std::move(other.m_owned_values);
     }
 
-    int bind(sqlite3_stmt* stmt, int index, const std::string& value)
-    {
-        return sqlite3_bind_text(stmt, index, value.data(), (int)value.length(), SQLITE_STATIC);
-    }
+    return *this;
+}
 
-    int bind(sqlite3_stmt* stmt, int index, const std::vector<char>& value)
-    {
-        return sqlite3_bind_blob(stmt, index, value.data(), (int)value.size(), SQLITE_STATIC);
-    }
+int statement::bind_text(int index, const char* text)
+{
+    return detail::bind(m_handle, index, text);
+}
 
-    int bind(sqlite3_stmt* stmt, int index, const void* src_ptr, size_t length)
-    {
-        return sqlite3_bind_blob(stmt, index, src_ptr, (int)length, SQLITE_STATIC);
-    }
+int statement::bind_text(int index, const std::string& text)
+{
+    return detail::bind(m_handle, index, text);
+}
 
-    int read(sqlite3_stmt* stmt, int index, int32_t& value)
-    {
-        if (sqlite3_column_type(stmt, index) != SQLITE_INTEGER)
-            return SQLITE_MISMATCH;
+int statement::bind_blob(int index, const std::vector<char>& blob)
+{
+    return detail::bind(m_handle, index, blob);
+}
 
-        value = sqlite3_column_int(stmt, index);
-        return SQLITE_OK;
-    }
+int statement::bind_text(int index, std::string&& text)
+{
+    return bind_owned(index, std::move(text));
+}
 
-    int read(sqlite3_stmt* stmt, int index, int64_t& value)
-    {
-        if (sqlite3_column_type(stmt, index) != SQLITE_INTEGER)
-            return SQLITE_MISMATCH;
+int statement::bind_text(int index, std::unique_ptr<char[]> text, size_t length)
+{
+    // SQLite calls the destructor even when the bind fails
+    return sqlite3_bind_text64(m_handle, index, text.release(), (sqlite3_uint64)length,
+        &detail::delete_char_array, SQLITE_UTF8);
+}
 
-        value = sqlite3_column_int64(stmt, index);
-        return SQLITE_OK;
-    }
+int statement::bind_blob(int index, std::vector<char>&& blob)
+{
+    return bind_owned(index, std::move(blob));
+}
 
-    int read(sqlite3_stmt* stmt, int index, double& value)
-    {
-        if (sqlite3_column_type(stmt, index) != SQLITE_FLOAT)
-            return SQLITE_MISMATCH;
+int statement::bind_blob(int index, std::unique_ptr<char[]> blob, size_t length)
+{
+    return sqlite3_bind_blob64(m_handle, index, blob.release(), (sqlite3_uint64)length,
+        &detail::delete_char_array);
+}
 
-        value = sqlite3_column_double(stmt, index);
-        return SQLITE_OK;
-    }
+int statement::bind_blob(int index, const void* ptr, size_t length)
+{
+    return detail::bind(m_handle, index, ptr, length);
+}
 
-    int read(sqlite3_stmt* stmt, int index, std::string& value)
-    {
-        if (sqlite3_column_type(stmt, index) != SQLITE_TEXT)
-            return SQLITE_MISMATCH;
+int statement::get_argument_index(const char* name) const
+{
+    return get_argument_index(parameter_name(name));
+}
 
-        value = reinterpret_cast<const char*>(sqlite3_column_text(stmt, index));
-        return SQLITE_OK;
+int statement::get_argument_index(const parameter_name& name) const
+{
+    if (!m_named_parameters_built)
+    {
+        build_named_parameters();
     }
 
-    int read(sqlite3_stmt* stmt, int index, std::vector<char>& value)
+    for (const auto& parameter : m_named_parameters)
     {
-        if (sqlite3_column_type(stmt, index) != SQLITE_BLOB)
-            return SQLITE_MISMATCH;
-
-        const auto* ptr = sqlite3_column_blob(stmt, index);
-        if (ptr != nullptr)
+        if ((parameter.hash == name.hash) && (parameter.name == name.text))
         {
-            const auto size = sqlite3_column_bytes(stmt, index);
-            value.resize(size);
-            memcpy(value.data(), ptr, size);
+            return parameter.index;
         }
-
-        return SQLITE_OK;
     }
 
-    int read(sqlite3_stmt* stmt, int index, void* dst_ptr, size_t length)
-    {
-        if (sqlite3_column_type(stmt, index) != SQLITE_BLOB)
-            return SQLITE_MISMATCH;
+    return 0;
+}
 
-        const auto size = sqlite3_column_bytes(stmt, index);
-        if (size != length)
-            return SQLITE_MISUSE;
+void statement::build_named_parameters() const
+{
+    m_named_parameters.clear();
 
-        const auto* src_ptr = sqlite3_column_blob(stmt, index);
-        if (src_ptr != nullptr)
+    // the names are copied, SQLite's own may not survive a reprepare
+    const int count = sqlite3_bind_parameter_count(m_handle);
+    for (int index = 1; index <= count; ++index)
+    {
+        const char* name = sqlite3_bind_parameter_name(m_handle, index);
+        if (name != nullptr)
         {
-            memcpy(dst_ptr, src_ptr, size);
+            m_named_parameters.push_back(detail::named_parameter{ detail::fnv1a(name), name, index });
         }
-
-        return SQLITE_OK;
     }
+
+    m_named_parameters_built = true;
 }
 
-statement::statement(statement&& other) noexcept
-    : m_handle(other.m_handle),
-    m_bind_index(other.m_bind_index),
-    m_read_index(other.m_read_index),
-    m_exec_status(other.m_exec_status),
-    m_exec_before_next_row(other.m_exec_before_next_row)
+int statement::reset()
 {
-    other.m_handle = nullptr;
+    m_bind_index = 0;
+    m_read_index = -1;
+    m_exec_status = SQLITE_OK;
+    m_exec_before_next_row = false;
+
+    return sqlite3_reset(m_handle);
 }
 
-statement& statement::operator=(statement&& other) noexcept
+int statement::clear_bindings()
 {
-    if (this != &other)
+    // the current row of a running statement may still point into owned values,
+    // and sqlite3_clear_bindings would free a bound array under its cursor
+    if (sqlite3_stmt_busy(m_handle))
     {
-        m_handle = other.m_handle;
-        other.m_handle = nullptr;
+        return SQLITE_MISUSE;
+    }
 
-        m_bind_index = other.m_bind_index;
-        m_read_index = other.m_read_index;
-        m_exec_status = other.m_exec_status;
-        m_exec_before_next_row = other.m_exec_before_next_row;
+    m_bind_index = 0;
+    const auto code = sqlite3_clear_bindings(m_handle);
+
+    // the slots stay around for the next binds, the data doesn't
+    for (auto& value : m_owned_values)
+    {
+        if (value)
+        {
+            std::string().swap(value->text);
+            std::vector<char>().swap(value->blob);
+        }
     }
 
-    return *this;
+    return code;
 }
 
-int statement::bind_text(int index, const char* text)
+detail::owned_value* statement::get_owned_value(int index)
 {
-    return detail::bind(m_handle, index, text);
+    if ((index < 1) || (index > sqlite3_bind_parameter_count(m_handle)))
+    {
+        return nullptr;
+    }
+
+    if ((size_t)index >= m_owned_values.size())
+    {
+        m_owned_values.resize((size_t)index + 1);
+    }
+
+    auto& value = m_owned_values[(size_t)index];
+    if (!value)
+    {
+        value.reset(new detail::owned_value());
+    }
+
+    return value.get();
 }
 
-int statement::bind_text(int index, const std::string& text)
+int statement::bind_owned(int index, std::string&& text)
 {
-    return detail::bind(m_handle, index, text);
+    // SQLite refuses binds on a running statement, whose current row may
+    // still point into the slot, so the slot must not be replaced either
+    if (sqlite3_stmt_busy(m_handle))
+    {
+        return SQLITE_MISUSE;
+    }
+
+    auto* value = get_owned_value(index);
+    if (value == nullptr)
+    {
+        return SQLITE_RANGE;
+    }
+
+    value->text = std::move(text);
+    return detail::bind(m_handle, index, value->text);
 }
 
-int statement::bind_blob(int index, const std::vector<char>& blob)
+int statement::bind_owned(int index, std::vector<char>&& blob)
 {
-    return detail::bind(m_handle, index, blob);
+    if (sqlite3_stmt_busy(m_handle))
+    {
+        return SQLITE_MISUSE;
+    }
+
+    auto* value = get_owned_value(index);
+    if (value == nullptr)
+    {
+        return SQLITE_RANGE;
+    }
+
+    value->blob = std::move(blob);
+    return detail::bind(m_handle, index, value->blob);
 }
 
-int statement::bind_blob(int index, const void* ptr, size_t length)
+int statement::bind_owned(int index, std::unique_ptr<char[]>&& text)
 {
-    return detail::bind(m_handle, index, ptr, length);
+    const size_t length = (text != nullptr) ? strlen(text.get()) : 0;
+    return bind_text(index, std::move(text), length);
 }
 
-int statement::get_argument_index(const char* name) const
+int statement::bind_owned(int index, std::vector<int64_t>&& values)
 {
-    return sqlite3_bind_parameter_index(m_handle, name);
+    return detail::bind(m_handle, index, std::move(values));
+}
+
+int statement::bind_owned(int index, std::vector<std::string>&& values)
+{
+    return detail::bind(m_handle, index, std::move(values));
 }
 
 bool statement::next_row()
@@ -178,11 +248,21 @@ int statement::read_text(int index, std::string& text) const
     return detail::read(m_handle, index, text);
 }
 
+int statement::read_text(int index, text_view& text) const
+{
+    return detail::read(m_handle, index, text);
+}
+
 int statement::read_blob(int index, std::vector<char>& value) const
 {
     return detail::read(m_handle, index, value);
 }
 
+int statement::read_blob(int index, blob_view& value) const
+{
+    return detail::read(m_handle, index, value);
+}
+
 int statement::read_blob(int index, void* ptr, size_t length) const
 {
     return detail::read(m_handle, index, ptr, length);
@@ -198,6 +278,31 @@ const char* statement::get_column_name(int index) const
     return sqlite3_column_name(m_handle, index);
 }
 
+bool statement::is_readonly() const
+{
+    return sqlite3_stmt_readonly(m_handle) != 0;
+}
+
+int statement::get_status(int op, bool reset) const
+{
+    return sqlite3_stmt_status(m_handle, op, reset ? 1 : 0);
+}
+
+statement_counters statement::get_counters(bool reset) const
+{
+    statement_counters counters;
+    counters.fullscan_steps = (uint64_t)get_status(SQLITE_STMTSTATUS_FULLSCAN_STEP, reset);
+    counters.sorts = (uint64_t)get_status(SQLITE_STMTSTATUS_SORT, reset);
+    counters.autoindexes = (uint64_t)get_status(SQLITE_STMTSTATUS_AUTOINDEX, reset);
+    counters.vm_steps = (uint64_t)get_status(SQLITE_STMTSTATUS_VM_STEP, reset);
+    counters.reprepares = (uint64_t)get_status(SQLITE_STMTSTATUS_REPREPARE, reset);
+    counters.runs = (uint64_t)get_status(SQLITE_STMTSTATUS_RUN, reset);
+    // memory in use can't be reset
+    counters.memory_used = (uint64_t)get_status(SQLITE_STMTSTATUS_MEMUSED);
+
+    return counters;
+}
+
 int statement::execute()
 {
     m_exec_status = sqlite3_step(m_handle);
@@ -0,0 +1,187 @@
+#include "sqlitepp_transaction.h"
+
+namespace sqlitepp
+{
+
+namespace
+{
+    const char* begin_query(transaction_mode mode)
+    {
+        switch (mode)
+        {
+        case transaction_mode::immediate:
+            return "BEGIN IMMEDIATE";
+        case transaction_mode::exclusive:
+            return "BEGIN EXCLUSIVE";
+        default:
+            return "BEGIN DEFERRED";
+        }
+    }
+
+    // "name" with embedded quotes doubled
+    std::string quote_identifier(const char* name)
+    {
+        std::string quoted = "\"";
+        for (const char* c = name; *c != '\0'; ++c)
+        {
+            if (*c == '"')
+            {
+                quoted += '"';
+            }
+
+            quoted += *c;
+        }
+
+        quoted += '"';
+        return quoted;
+    }
+}
+
+transaction::transaction(const database& db, transaction_mode mode)
+    : m_db(&db)
+{
+    m_status = m_db->execute_cached(begin_query(mode));
+    m_active = (m_status == SQLITE_OK);
+}
+
+transaction::transaction(transaction&& other) noexcept
+    : m_db(other.m_db),
+    m_active(other.m_active),
+    m_status(other.m_status)
+{
+    other.m_active = false;
+}
+
+transaction& transaction::operator=(transaction&& other) noexcept
+{
+    if (this != &other)
+    {
+        rollback();
+
+        m_db = other.m_db;
+        m_active = other.m_active;
+        m_status = other.m_status;
+
+        other.m_active = false;
+    }
+
+    return *this;
+}
+
+transaction::~transaction()
+{
+    rollback();
+}
+
+int transaction::commit()
+{
+    if (!m_active)
+    {
+        return SQLITE_MISUSE;
+    }
+
+    // on SQLITE_BUSY the transaction stays open so the commit can be retried
+    m_status = m_db->execute_cached("COMMIT");
+    if (m_status == SQLITE_OK)
+    {
+        m_active = false;
+    }
+
+    return m_status;
+}
+
+int transaction::rollback()
+{
+    if (!m_active)
+    {
+        return SQLITE_OK;
+    }
+
+    m_active = false;
+    m_status = m_db->execute_cached("ROLLBACK");
+
+    return m_status;
+}
+
+savepoint::savepoint(const database& db, const char* name)
+    : m_db(&db),
+    m_name(quote_identifier(name))
+{
+    m_status = execute("SAVEPOINT ");
+    m_active = (m_status == SQLITE_OK);
+}
+
+savepoint::savepoint(savepoint&& other) noexcept
+    : m_db(other.m_db),
+    m_name(std::move(other.m_name)),
+    m_active(other.m_active),
+    m_status(other.m_status)
+{
+    other.m_active = false;
+}
+
+savepoint& savepoint::operator=(savepoint&& other) noexcept
+{
+    if (this != &other)
+    {
+        rollback();
+
+        m_db = other.m_db;
+        m_name = std::move(other.m_name);
+        m_active = other.m_active;
+        m_status = other.m_status;
+
+        other.m_active = false;
+    }
+
+    return *this;
+}
+
+savepoint::~savepoint()
+{
+    rollback();
+}
+
+int savepoint::release()
+{
+    if (!m_active)
+    {
+        return SQLITE_MISUSE;
+    }
+
+    m_status = execute("RELEASE ");
+    if (m_status == SQLITE_OK)
+    {
+        m_active = false;
+    }
+
+    return m_status;
+}
+
+int savepoint::rollback()
+{
+    if (!m_active)
+    {
+        return SQLITE_OK;
+    }
+
+    m_active = false;
+
+    // ROLLBACK TO leaves the savepoint on the stack, so release it too
+    m_status = execute("ROLLBACK TO ");
+    if (m_status == SQLITE_OK)
+    {
+        m_status = execute("RELEASE ");
+    }
+
+    return m_status;
+}
+
+int savepoint::execute(const char* command) const
+{
+    // not cached, every savepoint name would take its own cache entries
+    const auto query = command + m_name;
+    return m_db->execute(query.c_str());
+}
+
+} // sqlitepp
@@ -0,0 +1,161 @@
+#include "sqlitepp_vtab.h"
+
+#include <cmath>
+
+namespace sqlitepp
+{
+
+namespace detail
+{
+    int best_key_index(sqlite3_index_info* info, int key_column, size_t rows)
+    {
+        int eq = -1;
+        int lower = -1;
+        int upper = -1;
+
+        for (int i = 0; (key_column >= 0) && (i < info->nConstraint); ++i)
+        {
+            const auto& constraint = info->aConstraint[i];
+            if (!constraint.usable || (constraint.iColumn != key_column))
+                continue;
+
+            switch (constraint.op)
+            {
+            case SQLITE_INDEX_CONSTRAINT_EQ:
+                eq = i;
+                break;
+
+            case SQLITE_INDEX_CONSTRAINT_GT:
+            case SQLITE_INDEX_CONSTRAINT_GE:
+                lower = i;
+                break;
+
+            case SQLITE_INDEX_CONSTRAINT_LT:
+            case SQLITE_INDEX_CONSTRAINT_LE:
+                upper = i;
+                break;
+            }
+        }
+
+        // an equality is just a range with both ends on the same value
+        if (eq >= 0)
+        {
+            lower = -1;
+            upper = -1;
+        }
+
+        int flags = 0;
+        int argument = 0;
+
+        // SQLite still checks the constraints itself (omit stays 0), so the
+        // search only has to return a superset, e.g. for non-integer values
+        if (eq >= 0)
+        {
+            flags |= key_eq;
+            info->aConstraintUsage[eq].argvIndex = ++argument;
+        }
+
+        if (lower >= 0)
+        {
+            flags |= key_lower;
+            if (info->aConstraint[lower].op == SQLITE_INDEX_CONSTRAINT_GT)
+                flags |= key_lower_exclusive;
+
+            info->aConstraintUsage[lower].argvIndex = ++argument;
+        }
+
+        if (upper >= 0)
+        {
+            flags |= key_upper;
+            if (info->aConstraint[upper].op == SQLITE_INDEX_CONSTRAINT_LT)
+                flags |= key_upper_exclusive;
+
+            info->aConstraintUsage[upper].argvIndex = ++argument;
+        }
+
+        info->idxNum = flags;
+
+        const double scan = (double)rows + 1;
+        if (flags & key_eq)
+        {
+            info->estimatedCost = 1 + std::log2(scan);
+            info->estimatedRows = 1;
+        }
+        else if ((flags & key_lower) && (flags & key_upper))
+        {
+            info->estimatedCost = std::log2(scan) + scan / 16;
+            info->estimatedRows = (sqlite3_int64)(rows / 16 + 1);
+        }
+        else if (flags != 0)
+        {
+            info->estimatedCost = std::log2(scan) + scan / 4;
+            info->estimatedRows = (sqlite3_int64)(rows / 4 + 1);
+        }
+        else
+        {
+            info->estimatedCost = scan;
+            info->estimatedRows = (sqlite3_int64)rows;
+        }
+
+        // rows come out in key order either way
+        if ((key_column >= 0) && (info->nOrderBy == 1) &&
+            (info->aOrderBy[0].iColumn == key_column) && !info->aOrderBy[0].desc)
+        {
+            info->orderByConsumed = 1;
+        }
+
+        return SQLITE_OK;
+    }
+
+    key_bounds make_key_bounds(int flags, int argc, sqlite3_value** argv)
+    {
+        key_bounds bounds;
+        int argument = 0;
+
+        // only integer values narrow the search, anything else keeps the
+        // bound open and is left to SQLite's own comparison
+        const auto integer = [&](int index) -> bool
+        {
+            return (index < argc) && (sqlite3_value_type(argv[index]) == SQLITE_INTEGER);
+        };
+
+        if (flags & key_eq)
+        {
+            if (integer(argument))
+            {
+                bounds.has_lower = bounds.has_upper = true;
+                bounds.lower = bounds.upper = sqlite3_value_int64(argv[argument]);
+            }
+
+            ++argument;
+        }
+
+        if (flags & key_lower)
+        {
+            if (integer(argument))
+            {
+                bounds.has_lower = true;
+                bounds.lower_exclusive = (flags & key_lower_exclusive) != 0;
+                bounds.lower = sqlite3_value_int64(argv[argument]);
+            }
+
+            ++argument;
+        }
+
+        if (flags & key_upper)
+        {
+            if (integer(argument))
+            {
+                bounds.has_upper = true;
+                bounds.upper_exclusive = (flags & key_upper_exclusive) != 0;
+                bounds.upper = sqlite3_value_int64(argv[argument]);
+            }
+
+            ++argument;
+        }
+
+        return bounds;
+    }
+}
+
+} // sqlitepp
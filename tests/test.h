@@ -0,0 +1,62 @@
+#ifndef SQLITEPP_TEST_H
+#define SQLITEPP_TEST_H
+
+#include <cstdio>
+#include <cstdint>
+
+#include "sqlitepp.h"
+
+namespace test
+{
+
+extern int failures;
+
+inline void check(bool passed, const char* condition, const char* file, int line)
+{
+    if (!passed)
+    {
+        std::printf("%s:%d: check failed: %s\n", file, line, condition);
+        ++failures;
+    }
+}
+
+#define TEST_CHECK(condition) ::test::check((condition), #condition, __FILE__, __LINE__)
+
+inline sqlitepp::database open_memory()
+{
+    int code = SQLITE_OK;
+    sqlitepp::database db(":memory:", code);
+    TEST_CHECK(code == SQLITE_OK);
+
+    return db;
+}
+
+void caching_allocator();
+void memory_regions();
+void global_settings();
+void array_module();
+void async_database();
+void reusable_statements();
+void bind_owned_values();
+void named_parameters();
+void blob_streams();
+void bulk_inserts();
+void statement_caching();
+void row_streams();
+void fetch_columns();
+void user_functions();
+void window_functions();
+void insert_many();
+void connection_pool();
+void profiling();
+void row_ranges();
+void scripts();
+void sql_literals();
+void statement_stats();
+void transactions();
+void column_views();
+void vector_tables();
+
+} // test
+
+#endif // SQLITEPP_TEST_H
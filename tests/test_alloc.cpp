@@ -0,0 +1,106 @@
+#include "test.h"
+
+#include <cstring>
+
+namespace test
+{
+
+void caching_allocator()
+{
+    using allocator = sqlitepp::thread_caching_allocator;
+
+    TEST_CHECK(allocator::allocate(0) == nullptr);
+    TEST_CHECK(allocator::round_up(1) == 16);
+    TEST_CHECK(allocator::round_up(17) == 32);
+    TEST_CHECK(allocator::round_up(4096) == 4096);
+    TEST_CHECK(allocator::round_up(4097) == 4104);
+
+    // small sizes come in whole size classes and are reused by the same thread
+    void* small = allocator::allocate(100);
+    TEST_CHECK(small != nullptr);
+    TEST_CHECK(allocator::size_of(small) == 128);
+    TEST_CHECK((reinterpret_cast<uintptr_t>(small) % 16) == 0);
+    allocator::release(small);
+
+    void* reused = allocator::allocate(120);
+    TEST_CHECK(reused == small);
+    TEST_CHECK(allocator::size_of(reused) == 128);
+
+    // growing within the class keeps the block, beyond it copies
+    memset(reused, 'x', 128);
+    TEST_CHECK(allocator::reallocate(reused, 128) == reused);
+
+    void* grown = allocator::reallocate(reused, 5000);
+    TEST_CHECK(grown != nullptr);
+    TEST_CHECK(allocator::size_of(grown) == 5000);
+    TEST_CHECK((static_cast<const char*>(grown)[0] == 'x') && (static_cast<const char*>(grown)[127] == 'x'));
+    allocator::release(grown);
+    allocator::release(nullptr);
+}
+
+void memory_regions()
+{
+    sqlitepp::memory_region empty;
+    TEST_CHECK(!empty.ok() && (empty.size() == 0));
+
+    const size_t size = 100 * 1024;
+
+    sqlitepp::memory_region plain(size, false);
+    TEST_CHECK(plain.ok() && !plain.is_huge_pages());
+    TEST_CHECK(plain.size() == size);
+    memset(plain.data(), 0, plain.size());
+
+    // without reserved huge pages this falls back to a plain region of the requested size
+    sqlitepp::memory_region huge(size, true);
+    TEST_CHECK(huge.ok());
+    TEST_CHECK(huge.is_huge_pages() ? (huge.size() >= size) : (huge.size() == size));
+    memset(huge.data(), 0, huge.size());
+
+    void* const data = plain.data();
+    sqlitepp::memory_region moved(std::move(plain));
+    TEST_CHECK(!plain.ok() && (plain.size() == 0));
+    TEST_CHECK((moved.data() == data) && (moved.size() == size));
+
+    huge = std::move(moved);
+    TEST_CHECK((huge.data() == data) && (huge.size() == size) && !moved.ok());
+}
+
+void global_settings()
+{
+    // nothing is open at this point, so the library can be shut down and configured
+    TEST_CHECK(sqlitepp::global_config::shutdown() == SQLITE_OK);
+
+    sqlite3_mem_methods previous;
+    TEST_CHECK(sqlitepp::global_config::get_allocator(previous) == SQLITE_OK);
+    TEST_CHECK(sqlitepp::global_config::set_allocator(sqlitepp::thread_caching_allocator::methods()) == SQLITE_OK);
+
+    sqlitepp::memory_region pages(64 * 1024, true);
+    TEST_CHECK(pages.ok());
+    TEST_CHECK(sqlitepp::global_config::set_page_cache(pages.data(), 1024 + 256, (int)(pages.size() / (1024 + 256))) == SQLITE_OK);
+    TEST_CHECK(sqlitepp::global_config::set_lookaside(128, 32) == SQLITE_OK);
+
+    TEST_CHECK(sqlitepp::global_config::initialize() == SQLITE_OK);
+    TEST_CHECK(sqlitepp::global_config::set_memory_status(false) == SQLITE_MISUSE);
+
+    {
+        auto db = open_memory();
+        TEST_CHECK(db.execute("CREATE TABLE t(a)") == SQLITE_OK);
+        TEST_CHECK(db.execute("WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 1000) "
+            "INSERT INTO t SELECT randomblob(i) FROM n") == SQLITE_OK);
+
+        auto stmt = db.prepare("SELECT sum(length(a)) FROM t");
+        TEST_CHECK(stmt.next_row());
+
+        int64_t total = 0;
+        TEST_CHECK(stmt.read_columns(total) == SQLITE_OK);
+        TEST_CHECK(total == 500500);
+    }
+
+    // the previous allocator for the tests that follow, the page cache region goes away with this scope
+    TEST_CHECK(sqlitepp::global_config::shutdown() == SQLITE_OK);
+    TEST_CHECK(sqlitepp::global_config::set_allocator(previous) == SQLITE_OK);
+    TEST_CHECK(sqlitepp::global_config::set_page_cache(nullptr, 0, 0) == SQLITE_OK);
+    TEST_CHECK(sqlitepp::global_config::initialize() == SQLITE_OK);
+}
+
+} // test
@@ -0,0 +1,50 @@
+#include "test.h"
+
+#include <string>
+#include <vector>
+
+namespace test
+{
+
+void array_module()
+{
+    auto db = open_memory();
+    TEST_CHECK(db.create_array_module() == SQLITE_OK);
+    TEST_CHECK(db.execute("CREATE TABLE t(id INTEGER PRIMARY KEY, name TEXT)") == SQLITE_OK);
+    TEST_CHECK(db.execute("INSERT INTO t VALUES (1, 'a'), (2, 'b'), (3, 'c'), (4, 'd')") == SQLITE_OK);
+
+    auto by_id = db.prepare("SELECT group_concat(name) FROM t WHERE id IN array(?)");
+    TEST_CHECK(by_id.bind_at(1, std::vector<int64_t>{ 4, 2, 9 }) == SQLITE_OK);
+    TEST_CHECK(by_id.next_row());
+
+    std::string names;
+    TEST_CHECK(by_id.read_columns(names) == SQLITE_OK);
+    TEST_CHECK(names == "b,d");
+
+    // the array is read while stepping, clearing it under the cursor is refused
+    auto values = db.prepare("SELECT value FROM array(?)");
+    TEST_CHECK(values.bind_at(1, std::vector<std::string>{ "x", "yy", "zzz" }) == SQLITE_OK);
+    TEST_CHECK(values.next_row());
+    TEST_CHECK(values.clear_bindings() == SQLITE_MISUSE);
+
+    std::string value;
+    TEST_CHECK(values.read_columns(value) == SQLITE_OK);
+    TEST_CHECK(value == "x");
+
+    TEST_CHECK(values.next_row());
+    TEST_CHECK(values.read_columns(value) == SQLITE_OK);
+    TEST_CHECK(value == "yy");
+
+    TEST_CHECK(values.next_row());
+    TEST_CHECK(values.read_columns(value) == SQLITE_OK);
+    TEST_CHECK(value == "zzz");
+    TEST_CHECK(!values.next_row());
+
+    // without an array there's nothing to scan
+    TEST_CHECK(values.reset() == SQLITE_OK);
+    TEST_CHECK(values.clear_bindings() == SQLITE_OK);
+    TEST_CHECK(!values.next_row());
+    TEST_CHECK(values.execution_status() == SQLITE_DONE);
+}
+
+} // test
@@ -0,0 +1,95 @@
+#include "test.h"
+
+#include <cstdio>
+#include <future>
+#include <stdexcept>
+
+namespace test
+{
+
+namespace
+{
+    const char* const async_file = "sqlitepp_test_async.db";
+
+    void remove_files()
+    {
+        std::remove(async_file);
+        std::remove("sqlitepp_test_async.db-wal");
+        std::remove("sqlitepp_test_async.db-shm");
+    }
+}
+
+void async_database()
+{
+    // nothing to run the jobs on before open()
+    sqlitepp::async_database closed;
+    TEST_CHECK(closed.post([](sqlitepp::database&) {}) == SQLITE_MISUSE);
+    TEST_CHECK(closed.get_pending_jobs(0) == 0);
+
+    auto orphan = closed.submit([](sqlitepp::database&) { return 1; });
+    bool broken = false;
+    try
+    {
+        orphan.get();
+    }
+    catch (const std::future_error& e)
+    {
+        broken = (e.code() == std::future_errc::broken_promise);
+    }
+
+    TEST_CHECK(broken);
+
+    remove_files();
+    {
+        sqlitepp::async_database db;
+        TEST_CHECK(db.open(async_file, 2, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, 100) == SQLITE_OK);
+        TEST_CHECK(db.get_worker_count() == 2);
+        TEST_CHECK(db.post_to(2, [](sqlitepp::database&) {}) == SQLITE_MISUSE);
+        TEST_CHECK(db.get_pending_jobs(2) == 0);
+
+        auto created = db.submit_to(0, [](sqlitepp::database& connection)
+        {
+            return connection.execute("CREATE TABLE t(a); INSERT INTO t VALUES (1), (2)");
+        });
+
+        TEST_CHECK(created.get() == SQLITE_OK);
+
+        // a throwing job doesn't take its worker down
+        TEST_CHECK(db.post_to(1, [](sqlitepp::database&) { throw std::runtime_error("job failed"); }) == SQLITE_OK);
+
+        auto sum = db.submit_to(1, [](sqlitepp::database& connection)
+        {
+            auto stmt = connection.prepare("SELECT sum(a) FROM t");
+            stmt.next_row();
+
+            int64_t value = 0;
+            stmt.read_columns(value);
+
+            return value;
+        });
+
+        TEST_CHECK(sum.get() == 3);
+
+        // submitted exceptions reach the future
+        auto failed = db.submit([](sqlitepp::database&) -> int { throw std::runtime_error("failed"); });
+        bool thrown = false;
+        try
+        {
+            failed.get();
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+
+        TEST_CHECK(thrown);
+
+        db.close();
+        TEST_CHECK(db.get_pending_jobs(0) == 0);
+        TEST_CHECK(db.post([](sqlitepp::database&) {}) == SQLITE_MISUSE);
+    }
+
+    remove_files();
+}
+
+} // test
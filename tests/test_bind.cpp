@@ -0,0 +1,117 @@
+#include "test.h"
+
+#include <memory>
+#include <string>
+#include <cstring>
+
+namespace test
+{
+
+void reusable_statements()
+{
+    auto db = open_memory();
+    TEST_CHECK(db.execute("CREATE TABLE t(a INTEGER, b TEXT)") == SQLITE_OK);
+
+    // one prepare, many runs
+    auto insert = db.prepare("INSERT INTO t VALUES (?, ?)");
+    for (int64_t i = 1; i <= 3; ++i)
+    {
+        TEST_CHECK(insert.rebind(i, std::to_string(i)) == SQLITE_OK);
+        TEST_CHECK(insert.execute() == SQLITE_OK);
+    }
+
+    // bindings survive a reset, so the same values run again
+    TEST_CHECK(insert.reset() == SQLITE_OK);
+    TEST_CHECK(insert.execute() == SQLITE_OK);
+
+    // and go back to NULL once cleared
+    TEST_CHECK(insert.reset() == SQLITE_OK);
+    TEST_CHECK(insert.clear_bindings() == SQLITE_OK);
+    TEST_CHECK(insert.execute() == SQLITE_OK);
+
+    auto stmt = db.prepare("SELECT count(*), count(a), sum(a), group_concat(b) FROM t");
+    TEST_CHECK(stmt.next_row());
+
+    int64_t rows = 0;
+    int64_t values = 0;
+    int64_t sum = 0;
+    std::string texts;
+    TEST_CHECK(stmt.read_columns(rows, values, sum, texts) == SQLITE_OK);
+    TEST_CHECK((rows == 5) && (values == 4) && (sum == 9) && (texts == "1,2,3,3"));
+
+    // rebinding starts the bind position over
+    auto pair = db.prepare("SELECT ? + ?");
+    TEST_CHECK(pair.rebind(1, 2) == SQLITE_OK);
+    TEST_CHECK(pair.next_row());
+    TEST_CHECK(pair.rebind(10, 20) == SQLITE_OK);
+    TEST_CHECK(pair.next_row());
+    TEST_CHECK(pair.read_columns(sum) == SQLITE_OK);
+    TEST_CHECK(sum == 30);
+}
+
+void bind_owned_values()
+{
+    auto db = open_memory();
+    auto stmt = db.prepare("SELECT ?1 UNION ALL SELECT ?1");
+
+    TEST_CHECK(stmt.bind_at(1, std::string(100, 'a')) == SQLITE_OK);
+    TEST_CHECK(stmt.next_row());
+
+    // the current row still points into the owned value
+    TEST_CHECK(stmt.bind_at(1, std::string(100, 'b')) == SQLITE_MISUSE);
+
+    std::string value;
+    TEST_CHECK(stmt.read_columns(value) == SQLITE_OK);
+    TEST_CHECK(value == std::string(100, 'a'));
+
+    TEST_CHECK(stmt.clear_bindings() == SQLITE_MISUSE);
+    TEST_CHECK(stmt.read_columns(value) == SQLITE_OK);
+    TEST_CHECK(value == std::string(100, 'a'));
+
+    // rebind starts over, so the row goes away before the value is replaced
+    TEST_CHECK(stmt.next_row());
+    TEST_CHECK(stmt.rebind(std::string(100, 'c')) == SQLITE_OK);
+    TEST_CHECK(stmt.next_row());
+    TEST_CHECK(stmt.read_columns(value) == SQLITE_OK);
+    TEST_CHECK(value == std::string(100, 'c'));
+
+    // a NUL terminated buffer, moved in without a length
+    std::unique_ptr<char[]> text(new char[6]);
+    memcpy(text.get(), "hello", 6);
+
+    TEST_CHECK(stmt.rebind(std::move(text)) == SQLITE_OK);
+    TEST_CHECK(stmt.next_row());
+    TEST_CHECK(stmt.read_columns(value) == SQLITE_OK);
+    TEST_CHECK(value == "hello");
+}
+
+void named_parameters()
+{
+    auto db = open_memory();
+    auto stmt = db.prepare("SELECT :a, @b, $c, :a, ?");
+
+    // every prefix, a repeated name keeps its first index and "?" takes the next free one
+    TEST_CHECK(stmt.get_argument_index(":a") == 1);
+    TEST_CHECK(stmt.get_argument_index("@b") == 2);
+    TEST_CHECK(stmt.get_argument_index("$c") == 3);
+    TEST_CHECK(stmt.get_argument_index(SQLITEPP_PARAM(":a")) == 1);
+    TEST_CHECK(stmt.get_argument_index(":missing") == 0);
+    TEST_CHECK(stmt.get_argument_index("a") == 0);
+
+    TEST_CHECK(stmt.bind_named(SQLITEPP_PARAM(":a"), 1) == SQLITE_OK);
+    TEST_CHECK(stmt.bind_named("@b", std::string("two")) == SQLITE_OK);
+    TEST_CHECK(stmt.bind_named("$c", 3.5) == SQLITE_OK);
+    TEST_CHECK(stmt.bind_named(":missing", 4) == SQLITE_RANGE);
+    TEST_CHECK(stmt.bind_at(4, 5) == SQLITE_OK);
+    TEST_CHECK(stmt.next_row());
+
+    int64_t a = 0;
+    std::string b;
+    double c = 0;
+    int64_t again = 0;
+    int64_t last = 0;
+    TEST_CHECK(stmt.read_columns(a, b, c, again, last) == SQLITE_OK);
+    TEST_CHECK((a == 1) && (b == "two") && (c == 3.5) && (again == 1) && (last == 5));
+}
+
+} // test
@@ -0,0 +1,45 @@
+#include "test.h"
+
+#include <vector>
+
+namespace test
+{
+
+void blob_streams()
+{
+    auto db = open_memory();
+    TEST_CHECK(db.execute("CREATE TABLE t(b BLOB)") == SQLITE_OK);
+
+    auto insert = db.prepare("INSERT INTO t VALUES (?)");
+    TEST_CHECK(insert.bind_at(1, sqlitepp::zeroblob{ 1000 }) == SQLITE_OK);
+    TEST_CHECK(insert.execute() == SQLITE_OK);
+
+    auto stream = db.open_blob("t", "b", 1, true);
+    TEST_CHECK(stream.ok());
+    TEST_CHECK(stream.size() == 1000);
+
+    const char data[] = "sqlitepp";
+    TEST_CHECK(stream.write(data, sizeof(data), 500) == SQLITE_OK);
+    TEST_CHECK(stream.write(data, sizeof(data), 995) != SQLITE_OK);
+
+    std::vector<char> content;
+    TEST_CHECK(stream.read_chunks(64, [&content](const void* chunk, size_t length)
+    {
+        const auto* bytes = static_cast<const char*>(chunk);
+        content.insert(content.end(), bytes, bytes + length);
+        return true;
+    }) == SQLITE_OK);
+
+    TEST_CHECK(content.size() == 1000);
+    TEST_CHECK(content[499] == '\0');
+    TEST_CHECK(std::string(&content[500]) == "sqlitepp");
+
+    size_t chunks = 0;
+    TEST_CHECK(stream.read_chunks(64, [&chunks](const void*, size_t) { return ++chunks < 2; }) == SQLITE_OK);
+    TEST_CHECK(chunks == 2);
+
+    TEST_CHECK(stream.close() == SQLITE_OK);
+    TEST_CHECK(stream.read_chunks(64, [](const void*, size_t) { return true; }) == SQLITE_MISUSE);
+}
+
+} // test
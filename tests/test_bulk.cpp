@@ -0,0 +1,53 @@
+#include "test.h"
+
+#include <array>
+#include <tuple>
+#include <string>
+#include <vector>
+
+namespace test
+{
+
+void bulk_inserts()
+{
+    const char* const columns[] = { "a", "b" };
+    TEST_CHECK(sqlitepp::detail::make_insert_sql("t", columns, 2, 2) == "INSERT INTO t (a,b) VALUES (?,?),(?,?)");
+
+    // largest first, clamped to the variable limit, always down to single rows
+    TEST_CHECK((sqlitepp::detail::make_batch_sizes(3, 32766) == std::vector<size_t>{ 256, 64, 16, 4, 1 }));
+    TEST_CHECK((sqlitepp::detail::make_batch_sizes(3, 30) == std::vector<size_t>{ 10, 4, 1 }));
+    TEST_CHECK((sqlitepp::detail::make_batch_sizes(3, 2) == std::vector<size_t>{ 1 }));
+
+    auto db = open_memory();
+    TEST_CHECK(db.execute("CREATE TABLE t(a INTEGER, b TEXT, c REAL)") == SQLITE_OK);
+
+    // a small limit makes the rows go through every statement size
+    db.set_limit(SQLITE_LIMIT_VARIABLE_NUMBER, 30);
+
+    std::vector<std::tuple<int64_t, std::string, double>> rows;
+    for (int64_t i = 1; i <= 23; ++i)
+    {
+        rows.emplace_back(i, std::to_string(i), (double)i / 2);
+    }
+
+    sqlitepp::bulk_insert<3> insert(db, "t", std::array<const char*, 3>{ { "a", "b", "c" } });
+    TEST_CHECK(insert.ok());
+    TEST_CHECK(insert.insert(rows) == SQLITE_OK);
+
+    auto stmt = db.prepare("SELECT count(*), sum(a), sum(CAST(b AS INTEGER)), sum(c) FROM t");
+    TEST_CHECK(stmt.next_row());
+
+    int64_t count = 0;
+    int64_t sum = 0;
+    int64_t text_sum = 0;
+    double half_sum = 0;
+    TEST_CHECK(stmt.read_columns(count, sum, text_sum, half_sum) == SQLITE_OK);
+    TEST_CHECK((count == 23) && (sum == 276) && (text_sum == 276) && (half_sum == 138.0));
+
+    // a failing prepare is kept as the status
+    sqlitepp::bulk_insert<1> missing(db, "no_such_table", std::array<const char*, 1>{ { "a" } });
+    TEST_CHECK(!missing.ok());
+    TEST_CHECK(missing.insert(std::vector<std::tuple<int64_t>>{ std::make_tuple(1) }) == missing.status());
+}
+
+} // test
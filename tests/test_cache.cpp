@@ -0,0 +1,65 @@
+#include "test.h"
+
+namespace test
+{
+
+void statement_caching()
+{
+    auto db = open_memory();
+    auto* cache = db.get_statement_cache();
+    TEST_CHECK(cache != nullptr);
+
+    {
+        auto first = db.prepare_cached("SELECT 1");
+        TEST_CHECK(first.ok());
+
+        // already leased, so the second one gets a statement of its own
+        auto second = db.prepare_cached("SELECT 1");
+        TEST_CHECK(second.ok());
+        TEST_CHECK(&first.get() != &second.get());
+        TEST_CHECK(cache->get_leases() == 2);
+        TEST_CHECK(cache->get_size() == 1);
+
+        // nothing can be closed while the leases are out
+        TEST_CHECK(db.close() == SQLITE_BUSY);
+    }
+
+    TEST_CHECK(cache->get_leases() == 0);
+
+    {
+        auto again = db.prepare_cached("SELECT 1");
+        TEST_CHECK(again.ok());
+    }
+
+    TEST_CHECK(cache->get_stats().hits == 1);
+    TEST_CHECK(cache->get_stats().misses == 2);
+
+    // least recently used entries go first
+    cache->set_capacity(2);
+    TEST_CHECK(db.execute_cached("SELECT 2") == SQLITE_OK);
+    TEST_CHECK(db.execute_cached("SELECT 1") == SQLITE_OK);
+    TEST_CHECK(db.execute_cached("SELECT 3") == SQLITE_OK);
+    TEST_CHECK(cache->get_size() == 2);
+    TEST_CHECK(cache->get_stats().evictions == 1);
+
+    cache->reset_stats();
+    TEST_CHECK(db.execute_cached("SELECT 1") == SQLITE_OK);
+    TEST_CHECK(db.execute_cached("SELECT 2") == SQLITE_OK);
+    TEST_CHECK(cache->get_stats().hits == 1);
+
+    TEST_CHECK(db.close() == SQLITE_OK);
+
+    // a lease can outlive its database, the connection closes when it's released
+    sqlitepp::cached_statement lease;
+    {
+        auto other = open_memory();
+        lease = other.prepare_cached("SELECT 42");
+        TEST_CHECK(lease.ok());
+    }
+
+    TEST_CHECK(lease.ok());
+    lease.release();
+    TEST_CHECK(!lease.ok());
+}
+
+} // test
@@ -0,0 +1,143 @@
+#include "test.h"
+#include "sqlitepp_coro.h"
+
+#ifdef SQLITEPP_HAS_COROUTINES
+
+#include <future>
+#include <string>
+#include <exception>
+
+#endif // SQLITEPP_HAS_COROUTINES
+
+namespace test
+{
+
+#ifdef SQLITEPP_HAS_COROUTINES
+
+namespace
+{
+    // runs eagerly, the future is ready once the coroutine body returned
+    struct task
+    {
+        struct promise_type
+        {
+            std::promise<void> done;
+
+            task get_return_object()
+            {
+                return task{ done.get_future() };
+            }
+
+            std::suspend_never initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void return_void()
+            {
+                done.set_value();
+            }
+
+            void unhandled_exception()
+            {
+                done.set_exception(std::current_exception());
+            }
+        };
+
+        std::future<void> finished;
+    };
+
+    struct totals
+    {
+        int64_t rows = 0;
+        int64_t sum = 0;
+        std::string last;
+    };
+
+    // the stream is owned by the caller, it has to go before the async_database
+    task consume(sqlitepp::row_stream<int64_t, std::string>& rows, totals& result)
+    {
+        // GCC 12 miscompiles co_await in a loop or short-circuit condition
+        for (;;)
+        {
+            const bool more = co_await rows.next();
+            if (!more)
+            {
+                break;
+            }
+
+            ++result.rows;
+            result.sum += std::get<0>(rows.row());
+            result.last = std::get<1>(rows.row());
+        }
+    }
+}
+
+#endif // SQLITEPP_HAS_COROUTINES
+
+void row_streams()
+{
+#ifdef SQLITEPP_HAS_COROUTINES
+    sqlitepp::async_database db;
+    TEST_CHECK(db.open(":memory:", 1) == SQLITE_OK);
+
+    auto created = db.submit_to(0, [](sqlitepp::database& connection)
+    {
+        return connection.execute("CREATE TABLE t(a, b); "
+            "WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 1000) "
+            "INSERT INTO t SELECT i, 'row ' || i FROM n");
+    });
+
+    TEST_CHECK(created.get() == SQLITE_OK);
+
+    // several batches, the last one partial
+    {
+        totals result;
+        sqlitepp::row_stream<int64_t, std::string> rows(db, 0, "SELECT a, b FROM t ORDER BY a", nullptr, 64);
+        consume(rows, result).finished.get();
+
+        TEST_CHECK((result.rows == 1000) && (result.sum == 500500) && (result.last == "row 1000"));
+        TEST_CHECK(rows.status() == SQLITE_OK);
+    }
+
+    // a row count that ends exactly on a batch boundary, with bound parameters
+    {
+        totals result;
+        sqlitepp::row_stream<int64_t, std::string> rows(db, 0, "SELECT a, b FROM t WHERE a <= ? ORDER BY a",
+            [](sqlitepp::statement& stmt) { return stmt.bind(128); }, 64);
+        consume(rows, result).finished.get();
+
+        TEST_CHECK((result.rows == 128) && (result.sum == 8256) && (result.last == "row 128"));
+        TEST_CHECK(rows.status() == SQLITE_OK);
+    }
+
+    // nothing to stream
+    {
+        totals result;
+        sqlitepp::row_stream<int64_t, std::string> rows(db, 0, "SELECT a, b FROM t WHERE a < 0");
+        consume(rows, result).finished.get();
+
+        TEST_CHECK(result.rows == 0);
+        TEST_CHECK(rows.status() == SQLITE_OK);
+    }
+
+    // errors end the stream and are kept in status()
+    {
+        totals result;
+        sqlitepp::row_stream<int64_t, std::string> rows(db, 0, "SELECT a, b FROM missing");
+        consume(rows, result).finished.get();
+
+        TEST_CHECK(result.rows == 0);
+        TEST_CHECK(rows.status() == SQLITE_ERROR);
+    }
+
+    db.close();
+#endif // SQLITEPP_HAS_COROUTINES
+}
+
+} // test
@@ -0,0 +1,43 @@
+#include "test.h"
+
+#include <string>
+
+namespace test
+{
+
+void fetch_columns()
+{
+    auto db = open_memory();
+    TEST_CHECK(db.execute("CREATE TABLE t(a, b, c)") == SQLITE_OK);
+    TEST_CHECK(db.execute("INSERT INTO t VALUES (1, 1.5, 'x'), (2, NULL, 'y'), (3, 3.5, 'z')") == SQLITE_OK);
+
+    auto stmt = db.prepare("SELECT a, b, c FROM t");
+
+    sqlitepp::column_batch<int64_t> a;
+    sqlitepp::column_batch<double> b;
+    sqlitepp::column_batch<std::string> c;
+
+    TEST_CHECK(stmt.fetch_columns(2, a, b, c) == SQLITE_ROW);
+    TEST_CHECK((a.size() == 2) && (b.size() == 2) && (c.size() == 2));
+    TEST_CHECK(!b.is_null(0) && b.is_null(1));
+    TEST_CHECK(c.values[1] == "y");
+
+    TEST_CHECK(stmt.fetch_columns(2, a, b, c) == SQLITE_DONE);
+    TEST_CHECK((a.size() == 3) && (b.size() == 3) && (c.size() == 3));
+    TEST_CHECK(a.values[2] == 3);
+
+    // the failing row is dropped from every column, not only the ones after the bad cell
+    TEST_CHECK(db.execute("INSERT INTO t VALUES (4, 4.5, 5)") == SQLITE_OK);
+
+    auto failing = db.prepare("SELECT a, b, c FROM t");
+    a.clear();
+    b.clear();
+    c.clear();
+
+    TEST_CHECK(failing.fetch_columns(10, a, b, c) != SQLITE_DONE);
+    TEST_CHECK((a.size() == 3) && (b.size() == 3) && (c.size() == 3));
+    TEST_CHECK((a.nulls.size() == 1) && (b.nulls.size() == 1) && (c.nulls.size() == 1));
+    TEST_CHECK((b.nulls[0] >> 3) == 0);
+}
+
+} // test
@@ -0,0 +1,116 @@
+#include "test.h"
+
+#include <stdexcept>
+
+namespace test
+{
+
+namespace
+{
+    struct sum_state
+    {
+        int64_t total = 0;
+
+        void step(int64_t value)
+        {
+            if (value < 0)
+            {
+                throw std::invalid_argument("negative value");
+            }
+
+            total += value;
+        }
+
+        int64_t value() const
+        {
+            return total;
+        }
+    };
+
+    struct window_sum
+    {
+        int64_t total = 0;
+
+        void step(int64_t value)
+        {
+            total += value;
+        }
+
+        void inverse(int64_t value)
+        {
+            total -= value;
+        }
+
+        int64_t value() const
+        {
+            return total;
+        }
+    };
+}
+
+void user_functions()
+{
+    auto db = open_memory();
+    TEST_CHECK(db.create_function("twice", [](int64_t value) { return value * 2; }) == SQLITE_OK);
+    TEST_CHECK(db.create_function("fail", [](int64_t) -> int64_t { throw std::runtime_error("failed"); }) == SQLITE_OK);
+    TEST_CHECK(db.create_aggregate<sum_state>("total") == SQLITE_OK);
+
+    auto scalar = db.prepare("SELECT twice(4), twice(NULL) IS NULL");
+    TEST_CHECK(scalar.next_row());
+
+    int64_t doubled = 0;
+    int64_t is_null = 0;
+    TEST_CHECK(scalar.read_columns(doubled, is_null) == SQLITE_OK);
+    TEST_CHECK((doubled == 8) && (is_null == 1));
+
+    auto failing = db.prepare("SELECT fail(1)");
+    TEST_CHECK(!failing.next_row());
+    TEST_CHECK(failing.execution_status() == SQLITE_ERROR);
+    TEST_CHECK(db.get_last_error() == SQLITE_ERROR);
+
+    TEST_CHECK(db.execute("CREATE TABLE t(x)") == SQLITE_OK);
+    TEST_CHECK(db.execute("INSERT INTO t VALUES (1), (NULL), (2)") == SQLITE_OK);
+
+    // rows with a NULL argument are skipped
+    auto aggregate = db.prepare("SELECT total(x) FROM t");
+    TEST_CHECK(aggregate.next_row());
+
+    int64_t sum = 0;
+    TEST_CHECK(aggregate.read_columns(sum) == SQLITE_OK);
+    TEST_CHECK(sum == 3);
+
+    TEST_CHECK(db.execute("INSERT INTO t VALUES (-1)") == SQLITE_OK);
+
+    auto throwing = db.prepare("SELECT total(x) FROM t");
+    TEST_CHECK(!throwing.next_row());
+    TEST_CHECK(throwing.execution_status() == SQLITE_ERROR);
+}
+
+void window_functions()
+{
+    auto db = open_memory();
+    TEST_CHECK(db.create_window_function<window_sum>("moving_sum", true) == SQLITE_OK);
+    TEST_CHECK(db.execute("CREATE TABLE t(x)") == SQLITE_OK);
+    TEST_CHECK(db.execute("INSERT INTO t VALUES (1), (2), (NULL), (4), (8)") == SQLITE_OK);
+
+    // rows leave the frame through inverse(), NULL rows are skipped both ways
+    auto stmt = db.prepare(
+        "SELECT group_concat(s) FROM (SELECT moving_sum(x) OVER "
+        "(ORDER BY rowid ROWS BETWEEN 1 PRECEDING AND CURRENT ROW) AS s FROM t)");
+    TEST_CHECK(stmt.next_row());
+
+    std::string sums;
+    TEST_CHECK(stmt.read_columns(sums) == SQLITE_OK);
+    TEST_CHECK(sums == "1,3,2,4,12");
+
+    // still a plain aggregate without OVER, with no rows at all as well
+    auto total = db.prepare("SELECT moving_sum(x), (SELECT moving_sum(x) FROM t WHERE x > 100) FROM t");
+    TEST_CHECK(total.next_row());
+
+    int64_t sum = 0;
+    int64_t empty = -1;
+    TEST_CHECK(total.read_columns(sum, empty) == SQLITE_OK);
+    TEST_CHECK((sum == 15) && (empty == 0));
+}
+
+} // test
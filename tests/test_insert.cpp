@@ -0,0 +1,57 @@
+#include "test.h"
+
+#include <tuple>
+#include <vector>
+
+namespace test
+{
+
+namespace
+{
+    typedef std::vector<std::tuple<int64_t>> row_list;
+
+    std::string values(const sqlitepp::database& db)
+    {
+        auto stmt = db.prepare("SELECT group_concat(a) FROM (SELECT a FROM t ORDER BY a)");
+        stmt.next_row();
+
+        std::string result;
+        stmt.read_columns(result);
+
+        return result;
+    }
+}
+
+void insert_many()
+{
+    auto db = open_memory();
+    TEST_CHECK(db.execute("CREATE TABLE t(a INTEGER UNIQUE)") == SQLITE_OK);
+
+    TEST_CHECK(db.insert_many("INSERT INTO t VALUES (?)", row_list{ std::make_tuple(1), std::make_tuple(2) }, 1) == SQLITE_OK);
+    TEST_CHECK(values(db) == "1,2");
+
+    {
+        sqlitepp::transaction tx(db);
+
+        // the commit interval can't commit the caller's transaction
+        TEST_CHECK(db.insert_many("INSERT INTO t VALUES (?)", row_list{ std::make_tuple(3), std::make_tuple(4) }, 1) == SQLITE_OK);
+
+        // a failing batch only rolls back its own rows
+        TEST_CHECK(db.insert_many("INSERT INTO t VALUES (?)", row_list{ std::make_tuple(5), std::make_tuple(1) }) != SQLITE_OK);
+        TEST_CHECK(values(db) == "1,2,3,4");
+
+        TEST_CHECK(tx.rollback() == SQLITE_OK);
+    }
+
+    TEST_CHECK(values(db) == "1,2");
+
+    {
+        sqlitepp::transaction tx(db);
+        TEST_CHECK(db.insert_many("INSERT INTO t VALUES (?)", row_list{ std::make_tuple(6) }) == SQLITE_OK);
+        TEST_CHECK(tx.commit() == SQLITE_OK);
+    }
+
+    TEST_CHECK(values(db) == "1,2,6");
+}
+
+} // test
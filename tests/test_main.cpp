@@ -0,0 +1,41 @@
+#include "test.h"
+
+int test::failures = 0;
+
+int main()
+{
+    test::caching_allocator();
+    test::memory_regions();
+    test::global_settings();
+    test::array_module();
+    test::async_database();
+    test::reusable_statements();
+    test::bind_owned_values();
+    test::named_parameters();
+    test::blob_streams();
+    test::bulk_inserts();
+    test::statement_caching();
+    test::row_streams();
+    test::fetch_columns();
+    test::user_functions();
+    test::window_functions();
+    test::insert_many();
+    test::connection_pool();
+    test::profiling();
+    test::row_ranges();
+    test::scripts();
+    test::sql_literals();
+    test::statement_stats();
+    test::transactions();
+    test::column_views();
+    test::vector_tables();
+
+    if (test::failures != 0)
+    {
+        std::printf("%d checks failed\n", test::failures);
+        return 1;
+    }
+
+    std::printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include "test.h"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+namespace test
+{
+
+namespace
+{
+    const char* const pool_file = "sqlitepp_test_pool.db";
+
+    void remove_files()
+    {
+        std::remove(pool_file);
+        std::remove("sqlitepp_test_pool.db-wal");
+        std::remove("sqlitepp_test_pool.db-shm");
+    }
+}
+
+void connection_pool()
+{
+    remove_files();
+    {
+        int code = SQLITE_ERROR;
+        sqlitepp::connection_pool pool(pool_file, 2, code);
+        TEST_CHECK(code == SQLITE_OK);
+        TEST_CHECK(pool.get_reader_count() == 2);
+
+        {
+            auto writer = pool.acquire_writer();
+            TEST_CHECK(writer.ok() && writer.is_writer());
+            TEST_CHECK(writer->execute("CREATE TABLE t(a)") == SQLITE_OK);
+        }
+
+        // statements that write are moved over to the writer
+        {
+            auto insert = pool.prepare("INSERT INTO t VALUES (?)", 7);
+            TEST_CHECK(insert.ok() && insert.is_writer());
+            TEST_CHECK(insert->execute() == SQLITE_OK);
+        }
+
+        {
+            auto select = pool.prepare("SELECT a FROM t");
+            TEST_CHECK(select.ok() && !select.is_writer());
+            TEST_CHECK(select->next_row());
+
+            int64_t value = 0;
+            TEST_CHECK(select->read_columns(value) == SQLITE_OK);
+            TEST_CHECK(value == 7);
+
+            // a leased connection is never closed or replaced under its user
+            TEST_CHECK(pool.close() == SQLITE_BUSY);
+            TEST_CHECK(pool.open(pool_file, 1) == SQLITE_BUSY);
+        }
+
+        {
+            // an idle lease without any statement still blocks close()
+            auto reader = pool.acquire_reader();
+            TEST_CHECK(reader.ok() && !reader.is_writer());
+            TEST_CHECK(pool.close() == SQLITE_BUSY);
+        }
+
+        TEST_CHECK(pool.close() == SQLITE_OK);
+        TEST_CHECK(!pool.acquire_writer().ok());
+        TEST_CHECK(!pool.acquire_reader().ok());
+
+        // without readers the writer serves reads too
+        TEST_CHECK(pool.open(pool_file, 0) == SQLITE_OK);
+        {
+            auto reader = pool.acquire_reader();
+            TEST_CHECK(reader.ok() && reader.is_writer());
+        }
+    }
+
+    // the destructor waits for leases held on other threads
+    sqlitepp::connection_lease lease;
+    std::thread holder;
+    {
+        int code = SQLITE_ERROR;
+        sqlitepp::connection_pool pool(pool_file, 1, code);
+        TEST_CHECK(code == SQLITE_OK);
+
+        lease = pool.acquire_reader();
+        TEST_CHECK(lease.ok());
+
+        holder = std::thread([&lease]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            lease.release();
+        });
+    }
+
+    holder.join();
+    TEST_CHECK(!lease.ok());
+
+    remove_files();
+}
+
+} // test
@@ -0,0 +1,70 @@
+#include "test.h"
+
+#include <string>
+
+namespace test
+{
+
+namespace
+{
+    sqlitepp::histogram_snapshot latency_of(const sqlitepp::query_profiler& profiler, const char* sql)
+    {
+        for (const auto& query : profiler.snapshot())
+        {
+            if (query.sql == sql)
+            {
+                return query.latency;
+            }
+        }
+
+        return sqlitepp::histogram_snapshot();
+    }
+}
+
+void profiling()
+{
+    // every value lands in a bucket whose upper bound isn't below it
+    for (uint64_t value = 0; value < 100000; value = value * 2 + 1)
+    {
+        const auto index = sqlitepp::latency_histogram::bucket_index(value);
+        TEST_CHECK(index < sqlitepp::latency_histogram::bucket_count);
+        TEST_CHECK(sqlitepp::latency_histogram::bucket_upper_bound(index) >= value);
+    }
+
+    sqlitepp::latency_histogram histogram;
+    for (uint64_t value = 1; value <= 100; ++value)
+    {
+        histogram.record(value * 1000);
+    }
+
+    const auto snapshot = histogram.snapshot();
+    TEST_CHECK(snapshot.count == 100);
+    TEST_CHECK(snapshot.max_ns == 100000);
+    TEST_CHECK(snapshot.percentile(100) == 100000);
+    TEST_CHECK((snapshot.percentile(50) >= 50000) && (snapshot.percentile(50) < 60000));
+
+    auto db = open_memory();
+
+    sqlitepp::query_profiler profiler;
+    TEST_CHECK(db.enable_profiling(profiler) == SQLITE_OK);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        auto stmt = db.prepare("SELECT 1");
+        TEST_CHECK(stmt.next_row());
+    }
+
+    TEST_CHECK(latency_of(profiler, "SELECT 1").count == 10);
+
+    // enabling again reuses the connection's histograms instead of attaching it twice
+    TEST_CHECK(db.disable_profiling() == SQLITE_OK);
+    TEST_CHECK(db.execute("SELECT 1") == SQLITE_OK);
+    TEST_CHECK(db.enable_profiling(profiler) == SQLITE_OK);
+    TEST_CHECK(db.enable_profiling(profiler) == SQLITE_OK);
+    TEST_CHECK(db.execute("SELECT 1") == SQLITE_OK);
+
+    TEST_CHECK(latency_of(profiler, "SELECT 1").count == 11);
+    TEST_CHECK(profiler.snapshot().size() == 1);
+}
+
+} // test
@@ -0,0 +1,61 @@
+#include "test.h"
+
+#include <string>
+#include <tuple>
+
+namespace test
+{
+
+void row_ranges()
+{
+    auto db = open_memory();
+    TEST_CHECK(db.execute("CREATE TABLE t(a INTEGER, b TEXT)") == SQLITE_OK);
+    TEST_CHECK(db.execute("INSERT INTO t VALUES (1, 'one'), (2, 'two'), (3, 'three')") == SQLITE_OK);
+
+    auto stmt = db.prepare("SELECT a, b FROM t ORDER BY a");
+
+    int64_t sum = 0;
+    std::string names;
+    auto rows = stmt.rows<int64_t, std::string>();
+    for (const auto& row : rows)
+    {
+        sum += std::get<0>(row);
+        names += std::get<1>(row);
+    }
+
+    TEST_CHECK(rows.status() == SQLITE_OK);
+    TEST_CHECK((sum == 6) && (names == "onetwothree"));
+
+    // after a reset the statement runs again
+    TEST_CHECK(stmt.reset() == SQLITE_OK);
+    size_t count = 0;
+    for (const auto& row : stmt.rows<int64_t, sqlitepp::text_view>())
+    {
+        TEST_CHECK(std::get<1>(row).length >= 3);
+        ++count;
+    }
+
+    TEST_CHECK(count == 3);
+
+    // a row that doesn't decode stops the iteration with the error
+    TEST_CHECK(db.execute("INSERT INTO t VALUES (4, x'00')") == SQLITE_OK);
+
+    auto failing = db.prepare("SELECT a, b FROM t ORDER BY a");
+    auto decoded = failing.rows<int64_t, sqlitepp::text_view>();
+
+    count = 0;
+    for (auto it = decoded.begin(); it != decoded.end(); ++it)
+    {
+        ++count;
+    }
+
+    TEST_CHECK(count == 3);
+    TEST_CHECK(decoded.status() == SQLITE_MISMATCH);
+
+    auto empty = db.prepare("SELECT a FROM t WHERE a > 100");
+    auto none = empty.rows<int64_t>();
+    TEST_CHECK(none.begin() == none.end());
+    TEST_CHECK(none.status() == SQLITE_OK);
+}
+
+} // test
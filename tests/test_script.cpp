@@ -0,0 +1,67 @@
+#include "test.h"
+
+#include <string>
+
+namespace test
+{
+
+void scripts()
+{
+    auto db = open_memory();
+
+    // later statements use the schema created by earlier ones, comments and blanks are skipped
+    TEST_CHECK(db.execute_script(
+        "CREATE TABLE t(a);\n"
+        "-- seed\n"
+        "INSERT INTO t VALUES (1), (2);\n"
+        "  ;  \n"
+        "INSERT INTO t SELECT a + 10 FROM t;") == SQLITE_OK);
+
+    auto count = db.prepare("SELECT count(*), sum(a) FROM t");
+    TEST_CHECK(count.next_row());
+
+    int64_t rows = 0;
+    int64_t sum = 0;
+    TEST_CHECK(count.read_columns(rows, sum) == SQLITE_OK);
+    TEST_CHECK((rows == 4) && (sum == 26));
+
+    // an error stops the script, the statements before it already ran
+    TEST_CHECK(db.execute_script("INSERT INTO t VALUES (100); INSERT INTO missing VALUES (1); INSERT INTO t VALUES (200);") != SQLITE_OK);
+
+    TEST_CHECK(count.reset() == SQLITE_OK);
+    TEST_CHECK(count.next_row());
+    TEST_CHECK(count.read_columns(rows, sum) == SQLITE_OK);
+    TEST_CHECK((rows == 5) && (sum == 126));
+
+    // a compiled script keeps its statements for the next runs
+    auto compiled = db.compile_script("DELETE FROM t WHERE a > ?; SELECT a FROM t ORDER BY a;");
+    TEST_CHECK(compiled.ok());
+    TEST_CHECK(compiled.get_statement_count() == 0);
+
+    std::string seen;
+    auto binder = [](sqlitepp::statement& stmt, size_t index)
+    {
+        return (index == 0) ? stmt.bind(int64_t(10)) : SQLITE_OK;
+    };
+
+    auto collect = [&seen](sqlitepp::statement& stmt, size_t index)
+    {
+        int64_t value = 0;
+        const auto code = stmt.read_columns(value);
+
+        seen += std::to_string(index) + ":" + std::to_string(value) + " ";
+        return code;
+    };
+
+    TEST_CHECK(compiled.run(binder, collect) == SQLITE_OK);
+    TEST_CHECK(compiled.is_compiled());
+    TEST_CHECK(compiled.get_statement_count() == 2);
+    TEST_CHECK(seen == "1:1 1:2 ");
+
+    // a row handler can stop the script
+    seen.clear();
+    TEST_CHECK(compiled.run(binder, [](sqlitepp::statement&, size_t) { return SQLITE_ABORT; }) == SQLITE_ABORT);
+    TEST_CHECK(compiled.run() == SQLITE_OK);
+}
+
+} // test
@@ -0,0 +1,93 @@
+#include "test.h"
+
+#include <string>
+
+namespace test
+{
+
+namespace
+{
+    using sqlitepp::detail::count_columns;
+    using sqlitepp::detail::count_parameters;
+
+    static_assert(count_parameters("SELECT ?, ?") == 2, "anonymous parameters");
+    static_assert(count_parameters("SELECT ?3, ?") == 4, "numbered parameters");
+    static_assert(count_parameters("SELECT :a, @b, :a, $c") == 3, "repeated names");
+    static_assert(count_parameters("SELECT $a::b, $a::b, $a") == 2, "TCL style names");
+    static_assert(count_parameters("SELECT 'it''s ?', \"?\", :x -- ?\n") == 1, "quoted text");
+    static_assert(count_parameters("SELECT ?; SELECT ?, ?") == 1, "only the first statement");
+
+    static_assert(count_columns("SELECT a, (SELECT b, c FROM t), f(d, e) FROM t") == 3, "nested lists");
+    static_assert(count_columns("SELECT * FROM t") == -1, "unknown columns");
+    static_assert(count_columns("INSERT INTO t VALUES (1)") == -1, "not a query");
+
+    // what SQLite itself makes of the text
+    void compare(sqlite3* handle, const char* sql)
+    {
+        sqlite3_stmt* stmt = nullptr;
+        TEST_CHECK(sqlite3_prepare_v2(handle, sql, -1, &stmt, nullptr) == SQLITE_OK);
+
+        TEST_CHECK(count_parameters(sql) == (size_t)sqlite3_bind_parameter_count(stmt));
+
+        const auto columns = count_columns(sql);
+        TEST_CHECK((columns < 0) || (columns == sqlite3_column_count(stmt)));
+
+        sqlite3_finalize(stmt);
+    }
+}
+
+void sql_literals()
+{
+    auto db = open_memory();
+    TEST_CHECK(db.execute("CREATE TABLE t(a, b)") == SQLITE_OK);
+
+    sqlite3* handle = nullptr;
+    TEST_CHECK(sqlite3_open(":memory:", &handle) == SQLITE_OK);
+    TEST_CHECK(sqlite3_exec(handle, "CREATE TABLE t(a, b)", nullptr, nullptr, nullptr) == SQLITE_OK);
+
+    const char* const queries[] =
+    {
+        "SELECT ?, ?",
+        "SELECT ?3, ?",
+        "SELECT :a, @b, :a, $c",
+        "SELECT $a::b, $a::b, $a",
+        "SELECT $x(y), $x(y), $x(z)",
+        "SELECT 'it''s ?', \"a\", :x FROM t -- ?\n",
+        "SELECT ?; SELECT ?, ?",
+        "SELECT a, b, (SELECT count(*) FROM t) FROM t WHERE a IN (?, ?)",
+        "SELECT a FROM t /* ?, :b */ WHERE b = :b",
+    };
+
+    for (const auto* sql : queries)
+    {
+        compare(handle, sql);
+    }
+
+    sqlite3_close(handle);
+
+    // the literal checks the argument count when preparing and the column count when reading
+    static constexpr auto query = SQLITEPP_SQL("SELECT ?1 + 1, ?1 * 2");
+    static_assert(query.parameters == 1, "one parameter");
+    static_assert(query.columns == 2, "two columns");
+
+    auto stmt = db.prepare(query, 5);
+    TEST_CHECK(stmt.next_row());
+
+    int64_t sum = 0;
+    int64_t product = 0;
+    TEST_CHECK(query.read_columns(stmt, sum, product) == SQLITE_OK);
+    TEST_CHECK((sum == 6) && (product == 10));
+
+    TEST_CHECK(stmt.reset() == SQLITE_OK);
+
+    size_t rows = 0;
+    for (const auto& row : query.rows<int64_t, int64_t>(stmt))
+    {
+        TEST_CHECK(std::get<1>(row) == 10);
+        ++rows;
+    }
+
+    TEST_CHECK(rows == 1);
+}
+
+} // test
@@ -0,0 +1,79 @@
+#include "test.h"
+
+#include <string>
+
+namespace test
+{
+
+namespace
+{
+    const char* const select_query = "SELECT * FROM t WHERE a > 0";
+
+    void run(sqlitepp::statement& stmt)
+    {
+        stmt.reset();
+        while (stmt.next_row())
+        {
+        }
+    }
+
+    sqlitepp::query_stats find(const sqlitepp::stats_registry& registry, const char* sql)
+    {
+        for (const auto& query : registry.snapshot())
+        {
+            if (query.sql == sql)
+            {
+                return query;
+            }
+        }
+
+        return sqlitepp::query_stats();
+    }
+}
+
+void statement_stats()
+{
+    auto db = open_memory();
+    TEST_CHECK(db.execute("CREATE TABLE t(a)") == SQLITE_OK);
+    TEST_CHECK(db.execute("INSERT INTO t VALUES (1), (2), (3)") == SQLITE_OK);
+
+    sqlitepp::stats_registry registry;
+    TEST_CHECK(db.enable_statement_stats(registry) == SQLITE_OK);
+
+    uint64_t fullscan_steps = 0;
+    {
+        auto stmt = db.prepare(select_query);
+        for (int i = 0; i < 3; ++i)
+        {
+            run(stmt);
+        }
+
+        // collecting the stats doesn't reset the statement's own counters
+        const auto counters = stmt.get_counters();
+        TEST_CHECK(counters.runs == 3);
+        TEST_CHECK(counters.fullscan_steps != 0);
+
+        fullscan_steps = counters.fullscan_steps / 3;
+
+        // counters reset by the user only lose what ran before the reset
+        stmt.get_counters(true);
+        run(stmt);
+    }
+
+    auto query = find(registry, select_query);
+    TEST_CHECK(query.totals.runs == 4);
+    TEST_CHECK(query.totals.fullscan_steps == 4 * fullscan_steps);
+
+    // the same query prepared over and over, SQLite hands out the freed addresses again
+    for (int i = 0; i < 5; ++i)
+    {
+        auto stmt = db.prepare(select_query);
+        run(stmt);
+    }
+
+    query = find(registry, select_query);
+    TEST_CHECK(query.totals.runs == 9);
+    TEST_CHECK(query.totals.fullscan_steps == 9 * fullscan_steps);
+}
+
+} // test
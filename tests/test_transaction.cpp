@@ -0,0 +1,95 @@
+#include "test.h"
+
+#include <string>
+#include <utility>
+
+namespace test
+{
+
+namespace
+{
+    int64_t count_rows(const sqlitepp::database& db)
+    {
+        auto stmt = db.prepare("SELECT count(*) FROM t");
+        stmt.next_row();
+
+        int64_t count = -1;
+        stmt.read_columns(count);
+
+        return count;
+    }
+}
+
+void transactions()
+{
+    auto db = open_memory();
+    TEST_CHECK(db.execute("CREATE TABLE t(a)") == SQLITE_OK);
+
+    {
+        sqlitepp::transaction tx(db, sqlitepp::transaction_mode::immediate);
+        TEST_CHECK(tx.ok() && tx.is_active());
+        TEST_CHECK(db.execute("INSERT INTO t VALUES (1)") == SQLITE_OK);
+        TEST_CHECK(tx.commit() == SQLITE_OK);
+        TEST_CHECK(!tx.is_active());
+        TEST_CHECK(tx.commit() == SQLITE_MISUSE);
+    }
+
+    TEST_CHECK(count_rows(db) == 1);
+
+    // rolled back unless committed, also after being moved
+    {
+        sqlitepp::transaction tx(db, sqlitepp::transaction_mode::exclusive);
+        TEST_CHECK(db.execute("INSERT INTO t VALUES (2)") == SQLITE_OK);
+
+        sqlitepp::transaction moved(std::move(tx));
+        TEST_CHECK(!tx.is_active() && moved.is_active());
+    }
+
+    TEST_CHECK(count_rows(db) == 1);
+
+    {
+        sqlitepp::transaction tx(db);
+        TEST_CHECK(db.execute("INSERT INTO t VALUES (3)") == SQLITE_OK);
+
+        {
+            // names are quoted, so anything goes
+            sqlitepp::savepoint inner(db, "it's \"inner\"");
+            TEST_CHECK(inner.ok());
+            TEST_CHECK(db.execute("INSERT INTO t VALUES (4)") == SQLITE_OK);
+        }
+
+        TEST_CHECK(count_rows(db) == 2);
+
+        {
+            sqlitepp::savepoint kept(db, "kept");
+            TEST_CHECK(db.execute("INSERT INTO t VALUES (5)") == SQLITE_OK);
+            TEST_CHECK(kept.release() == SQLITE_OK);
+            TEST_CHECK(kept.release() == SQLITE_MISUSE);
+        }
+
+        TEST_CHECK(tx.commit() == SQLITE_OK);
+    }
+
+    TEST_CHECK(count_rows(db) == 3);
+
+    // a savepoint outside of a transaction starts one of its own
+    {
+        sqlitepp::savepoint outer(db, "outer");
+        TEST_CHECK(db.execute("INSERT INTO t VALUES (6)") == SQLITE_OK);
+        TEST_CHECK(outer.rollback() == SQLITE_OK);
+    }
+
+    TEST_CHECK(count_rows(db) == 3);
+
+    // the commands run uncached, so savepoint names don't pile up in the cache
+    const auto cached = db.get_statement_cache()->get_size();
+    for (int i = 0; i < 10; ++i)
+    {
+        sqlitepp::savepoint sp(db, ("sp" + std::to_string(i)).c_str());
+        TEST_CHECK(sp.release() == SQLITE_OK);
+    }
+
+    TEST_CHECK(db.get_statement_cache()->get_size() == cached);
+}
+
+} // test
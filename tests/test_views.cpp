@@ -0,0 +1,39 @@
+#include "test.h"
+
+#include <string>
+#include <cstring>
+
+namespace test
+{
+
+void column_views()
+{
+    auto db = open_memory();
+
+    auto stmt = db.prepare("SELECT ?, ?, 'abc', x'00ff10', NULL");
+
+    // views bind without a copy, the data only has to outlive the step
+    const char text[] = "bound text";
+    const unsigned char bytes[] = { 1, 2, 3, 4 };
+    TEST_CHECK(stmt.bind(sqlitepp::text_view{ text, 5 }, sqlitepp::blob_view{ bytes, sizeof(bytes) }) == SQLITE_OK);
+    TEST_CHECK(stmt.next_row());
+
+    sqlitepp::text_view bound_text = { nullptr, 0 };
+    sqlitepp::blob_view bound_blob = { nullptr, 0 };
+    sqlitepp::text_view literal_text = { nullptr, 0 };
+    sqlitepp::blob_view literal_blob = { nullptr, 0 };
+    TEST_CHECK(stmt.read_columns(bound_text, bound_blob, literal_text, literal_blob) == SQLITE_OK);
+
+    TEST_CHECK(std::string(bound_text.ptr, bound_text.length) == "bound");
+    TEST_CHECK((bound_blob.length == 4) && (memcmp(bound_blob.ptr, bytes, 4) == 0));
+    TEST_CHECK(std::string(literal_text.ptr, literal_text.length) == "abc");
+    TEST_CHECK((literal_blob.length == 3) && (static_cast<const unsigned char*>(literal_blob.ptr)[1] == 0xff));
+
+    // a view only points at a value of its own type
+    sqlitepp::text_view wrong_text = { nullptr, 0 };
+    sqlitepp::blob_view wrong_blob = { nullptr, 0 };
+    TEST_CHECK(stmt.read_column_at(3, wrong_text) == SQLITE_MISMATCH);
+    TEST_CHECK(stmt.read_column_at(4, wrong_blob) == SQLITE_MISMATCH);
+}
+
+} // test
@@ -0,0 +1,82 @@
+#include "test.h"
+
+#include <string>
+#include <vector>
+
+namespace test
+{
+
+namespace
+{
+    struct employee
+    {
+        int64_t id;
+        std::string name;
+        double salary;
+    };
+}
+
+void vector_tables()
+{
+    // sorted by id, which makes it usable as the key
+    const std::vector<employee> rows =
+    {
+        { 1, "ada", 10.5 },
+        { 3, "bob", 20.0 },
+        { 4, "cy", 30.25 },
+        { 7, "dee", 40.0 },
+    };
+
+    sqlitepp::vector_table<employee> table(rows);
+    table.key("id", &employee::id)
+        .column("name", &employee::name)
+        .column("salary", &employee::salary);
+
+    TEST_CHECK(table.get_schema() == "CREATE TABLE x(\"id\" INTEGER, \"name\" TEXT, \"salary\" REAL)");
+
+    auto db = open_memory();
+    TEST_CHECK(db.create_module("employees", table) == SQLITE_OK);
+
+    auto all = db.prepare("SELECT count(*), sum(salary), group_concat(name) FROM employees");
+    TEST_CHECK(all.next_row());
+
+    int64_t count = 0;
+    double total = 0;
+    std::string names;
+    TEST_CHECK(all.read_columns(count, total, names) == SQLITE_OK);
+    TEST_CHECK((count == 4) && (total == 100.75) && (names == "ada,bob,cy,dee"));
+
+    // constraints on the key, equal and in ranges with either bound open or closed
+    const char* const queries[] =
+    {
+        "SELECT group_concat(name) FROM employees WHERE id = 4",
+        "SELECT group_concat(name) FROM employees WHERE id = 5",
+        "SELECT group_concat(name) FROM employees WHERE id > 3",
+        "SELECT group_concat(name) FROM employees WHERE id >= 3 AND id < 7",
+        "SELECT group_concat(name) FROM employees WHERE id <= 3",
+        "SELECT group_concat(name) FROM employees WHERE name = 'cy'",
+    };
+
+    const char* const expected[] = { "cy", "", "cy,dee", "bob,cy", "ada,bob", "cy" };
+
+    for (size_t i = 0; i < sizeof(queries) / sizeof(queries[0]); ++i)
+    {
+        auto stmt = db.prepare(queries[i]);
+        TEST_CHECK(stmt.next_row());
+
+        std::string result;
+        const auto code = stmt.read_columns(result);
+        TEST_CHECK((code == SQLITE_OK) ? (result == expected[i]) : (expected[i][0] == '\0'));
+    }
+
+    // joins go through the key too
+    TEST_CHECK(db.execute("CREATE TABLE wanted(id INTEGER)") == SQLITE_OK);
+    TEST_CHECK(db.execute("INSERT INTO wanted VALUES (7), (1), (2)") == SQLITE_OK);
+
+    auto join = db.prepare("SELECT group_concat(e.name) FROM wanted w JOIN employees e ON e.id = w.id");
+    TEST_CHECK(join.next_row());
+    TEST_CHECK(join.read_columns(names) == SQLITE_OK);
+    TEST_CHECK(names == "dee,ada");
+}
+
+} // test